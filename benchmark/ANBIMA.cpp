@@ -0,0 +1,177 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <boost/multiprecision/cpp_dec_float.hpp>
+
+#include <vector>
+#include <chrono>
+
+#include <benchmark/benchmark.h>
+
+#include <resets_math.h>
+
+#include <frequency.h>
+
+#include <ANBIMA.h>
+#include <bill.h>
+#include <bond.h>
+#include <quote.h>
+
+#include "setup.h"
+
+using namespace boost::multiprecision;
+
+
+namespace debt_security
+{
+
+	template<typename T>
+	static void ANBIMA_price_bill(benchmark::State& state)
+	{
+		const auto face = T{ 1'000 };
+		const auto b = bill<T>{ settlement_date, bill_maturity(state), anbima_calendar(), face };
+		const auto q = quote<T>{ settlement_date, face, 6u };
+		const auto yield = reset::from_percent(T{ 1'436 } / T{ 100 });
+
+		const auto ym = ANBIMA<T>{};
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(ym.price(yield, b, q));
+	}
+
+	BENCHMARK_TEMPLATE(ANBIMA_price_bill, double)->Apply(bill_maturities);
+	BENCHMARK_TEMPLATE(ANBIMA_price_bill, cpp_dec_float_50)->Apply(bill_maturities);
+
+
+	template<typename T>
+	static void ANBIMA_price_bond(benchmark::State& state)
+	{
+		const auto face = T{ 1'000 };
+		const auto b = bond<T>{ bond_issue_date, bond_maturity(state), fin_calendar::SemiAnnual, T{ 10 }, anbima_calendar(), face, 5u };
+		const auto q = quote<T>{ settlement_date, face, 6u };
+		const auto yield = reset::from_percent(T{ 1'366 } / T{ 100 });
+
+		const auto ym = ANBIMA<T>{};
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(ym.price(yield, b, q));
+	}
+
+	BENCHMARK_TEMPLATE(ANBIMA_price_bond, double)->Apply(bond_maturities);
+	BENCHMARK_TEMPLATE(ANBIMA_price_bond, cpp_dec_float_50)->Apply(bond_maturities);
+
+	// a screen of bonds over all the maturities of bond_maturities, scalar against vectorised
+	static auto _bond_screen(benchmark::State& state) -> std::vector<bond<double>>
+	{
+		auto result = std::vector<bond<double>>{};
+		for (auto i = 0; i < state.range(0); ++i)
+			result.emplace_back(bond_issue_date, bond_issue_date + std::chrono::years{ 1 + i % 50 }, fin_calendar::SemiAnnual, 10.0, anbima_calendar(), 1'000.0, 5u);
+		return result;
+	}
+
+	static void ANBIMA_price_batch_bond(benchmark::State& state)
+	{
+		const auto bonds = _bond_screen(state);
+		const auto yields = std::vector<double>(bonds.size(), reset::from_percent(13.66));
+		const auto q = quote<double>{ settlement_date, 1'000.0, 6u };
+
+		const auto ym = ANBIMA<double>{};
+
+		auto prices = std::vector<double>(bonds.size());
+		for (auto _ : state)
+		{
+			ym.price_batch(yields, bonds, q, prices);
+			benchmark::DoNotOptimize(prices.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	BENCHMARK(ANBIMA_price_batch_bond)->Arg(1'000);
+
+	static void ANBIMA_price_batch_vectorised_bond(benchmark::State& state)
+	{
+		const auto bonds = _bond_screen(state);
+		const auto yields = std::vector<double>(bonds.size(), reset::from_percent(13.66));
+		const auto q = quote<double>{ settlement_date, 1'000.0, 6u };
+
+		const auto ym = ANBIMA<double>{};
+
+		auto prices = std::vector<double>(bonds.size());
+		for (auto _ : state)
+		{
+			ym.price_batch_vectorised(yields, bonds, q, prices);
+			benchmark::DoNotOptimize(prices.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	BENCHMARK(ANBIMA_price_batch_vectorised_bond)->Arg(1'000);
+
+	// an auction: one bill at many bids, one price at a time against all at once
+	template<typename T>
+	static void ANBIMA_price_bids(benchmark::State& state)
+	{
+		const auto face = T{ 1'000 };
+		const auto b = bill<T>{ settlement_date, bill_maturity(state), anbima_calendar(), face };
+		const auto q = quote<T>{ settlement_date, face, 6u };
+
+		auto yields = std::vector<T>{};
+		for (auto bid = 0; bid < 100; ++bid)
+			yields.push_back(reset::from_percent(static_cast<T>(1'400 + bid) / T{ 100 }));
+
+		const auto ym = ANBIMA<T>{};
+
+		auto prices = std::vector<T>(yields.size());
+		for (auto _ : state)
+		{
+			for (auto i = 0uz; i < yields.size(); ++i)
+				prices[i] = ym.price(yields[i], b, q);
+			benchmark::DoNotOptimize(prices.data());
+		}
+	}
+
+	BENCHMARK_TEMPLATE(ANBIMA_price_bids, double)->Arg(730);
+
+	template<typename T>
+	static void ANBIMA_price_at_yields(benchmark::State& state)
+	{
+		const auto face = T{ 1'000 };
+		const auto b = bill<T>{ settlement_date, bill_maturity(state), anbima_calendar(), face };
+		const auto q = quote<T>{ settlement_date, face, 6u };
+
+		auto yields = std::vector<T>{};
+		for (auto bid = 0; bid < 100; ++bid)
+			yields.push_back(reset::from_percent(static_cast<T>(1'400 + bid) / T{ 100 }));
+
+		const auto ym = ANBIMA<T>{};
+
+		auto prices = std::vector<T>(yields.size());
+		for (auto _ : state)
+		{
+			ym.price_at_yields(yields, b, q, prices);
+			benchmark::DoNotOptimize(prices.data());
+		}
+	}
+
+	BENCHMARK_TEMPLATE(ANBIMA_price_at_yields, double)->Arg(730);
+
+}
@@ -0,0 +1,56 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <boost/multiprecision/cpp_dec_float.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <bill.h>
+#include <shared_calendar.h>
+
+#include "setup.h"
+
+using namespace boost::multiprecision;
+
+
+namespace debt_security
+{
+
+	// construction and the (otherwise memoised) cash flow
+	template<typename T>
+	static void bill_cash_flow(benchmark::State& state)
+	{
+		const auto calendar = intern_calendar(anbima_calendar());
+		const auto maturity_date = bill_maturity(state);
+		const auto face = T{ 1'000 };
+
+		for (auto _ : state)
+		{
+			const auto b = bill<T>{ settlement_date, maturity_date, calendar, face };
+			benchmark::DoNotOptimize(b.cash_flow());
+		}
+	}
+
+	BENCHMARK_TEMPLATE(bill_cash_flow, double)->Apply(bill_maturities);
+	BENCHMARK_TEMPLATE(bill_cash_flow, cpp_dec_float_50)->Apply(bill_maturities);
+
+}
@@ -0,0 +1,67 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+
+#include <benchmark/benchmark.h>
+
+#include <calculation_252.h>
+
+#include <business_day_index.h>
+
+#include "setup.h"
+
+
+namespace debt_security
+{
+
+	static void calculation_252_fraction(benchmark::State& state)
+	{
+		const auto dc = fin_calendar::calculation_252{ anbima_calendar() };
+		const auto maturity_date = bill_maturity(state);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(dc.fraction(settlement_date, maturity_date));
+	}
+
+	BENCHMARK(calculation_252_fraction)->Apply(bill_maturities);
+
+
+	// what ANBIMA uses instead (once the index is located)
+	static void business_day_index_business_days(benchmark::State& state)
+	{
+		const auto maturity_date = bill_maturity(state);
+		const auto index = locate_business_day_index(
+			anbima_calendar(),
+			gregorian::util::days_period{ settlement_date, maturity_date }
+		);
+
+		const auto from = std::chrono::sys_days{ settlement_date };
+		const auto until = std::chrono::sys_days{ maturity_date };
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(index->business_days(from, until));
+	}
+
+	BENCHMARK(business_day_index_business_days)->Apply(bill_maturities);
+
+}
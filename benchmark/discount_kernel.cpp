@@ -0,0 +1,82 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+
+#include <discount_kernel.h>
+
+#include <cmath>
+#include <vector>
+
+
+namespace debt_security
+{
+
+	static void discount_factors(benchmark::State& state, vector_isa isa)
+	{
+		if (!is_supported(isa))
+		{
+			state.SkipWithError("Instruction set is not supported by this cpu");
+			return;
+		}
+
+		const auto n = static_cast<std::size_t>(state.range(0));
+		const auto log_bases = std::vector<double>(n, std::log(1.1366));
+		auto year_fractions = std::vector<double>(n);
+		for (auto i = 0uz; i < n; ++i)
+			year_fractions[i] = static_cast<double>(i % 12'600) / 252.0; // up to 50 years
+
+		auto factors = std::vector<double>(n);
+		for (auto _ : state)
+		{
+			debt_security::discount_factors(isa, log_bases, year_fractions, factors);
+			benchmark::DoNotOptimize(factors.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	BENCHMARK_CAPTURE(discount_factors, portable, vector_isa::portable)->Arg(4'096);
+	BENCHMARK_CAPTURE(discount_factors, avx2, vector_isa::avx2)->Arg(4'096);
+	BENCHMARK_CAPTURE(discount_factors, avx512, vector_isa::avx512)->Arg(4'096);
+
+
+	// what the kernel replaces
+	static void pow_discount_factors(benchmark::State& state)
+	{
+		const auto n = static_cast<std::size_t>(state.range(0));
+		auto year_fractions = std::vector<double>(n);
+		for (auto i = 0uz; i < n; ++i)
+			year_fractions[i] = static_cast<double>(i % 12'600) / 252.0;
+
+		auto factors = std::vector<double>(n);
+		for (auto _ : state)
+		{
+			for (auto i = 0uz; i < n; ++i)
+				factors[i] = 1.0 / std::pow(1.1366, year_fractions[i]);
+			benchmark::DoNotOptimize(factors.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	BENCHMARK(pow_discount_factors)->Arg(4'096);
+
+}
@@ -0,0 +1,72 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+
+#include <benchmark/benchmark.h>
+
+#include <calendar.h>
+#include <static_data.h>
+
+
+namespace debt_security
+{
+
+	// the same settlement date as in the ANBIMA papers
+	constexpr auto settlement_date = std::chrono::year_month_day{ std::chrono::year{ 2008 }, std::chrono::May, std::chrono::day{ 21 } };
+
+	inline auto anbima_calendar() -> const gregorian::calendar&
+	{
+		return gregorian::static_data::locate_calendar("America/ANBIMA");
+	}
+
+
+	// from 1 day to 50 years after the settlement date
+	inline auto bill_maturities(benchmark::internal::Benchmark* b) -> void
+	{
+		for (const auto days : { 1, 7, 30, 91, 182, 365, 730, 1'826, 3'652, 7'305, 10'957, 18'262 })
+			b->Arg(days);
+	}
+
+	inline auto bill_maturity(const benchmark::State& state) -> std::chrono::year_month_day
+	{
+		return std::chrono::sys_days{ settlement_date } + std::chrono::days{ state.range(0) };
+	}
+
+
+	// bonds are issued on the 1st of January before the settlement date, so the shortest one still has a flow after it
+	inline auto bond_maturities(benchmark::internal::Benchmark* b) -> void
+	{
+		for (const auto years : { 1, 2, 3, 5, 10, 20, 30, 50 })
+			b->Arg(years);
+	}
+
+	constexpr auto bond_issue_date = std::chrono::year_month_day{ std::chrono::year{ 2008 }, std::chrono::January, std::chrono::day{ 1 } };
+
+	inline auto bond_maturity(const benchmark::State& state) -> std::chrono::year_month_day
+	{
+		return bond_issue_date + std::chrono::years{ state.range(0) };
+	}
+
+}
@@ -0,0 +1,76 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <boost/multiprecision/cpp_dec_float.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <resets_math.h>
+
+#include <yield_methodology.h>
+#include <bill.h>
+#include <quote.h>
+
+#include "setup.h"
+
+using namespace boost::multiprecision;
+
+
+namespace debt_security
+{
+
+	// the same as ANBIMA_price_bill, but through the variant
+	template<typename T>
+	static void yield_to_price_bill(benchmark::State& state)
+	{
+		const auto face = T{ 1'000 };
+		const auto b = bill<T>{ settlement_date, bill_maturity(state), anbima_calendar(), face };
+		const auto q = quote<T>{ settlement_date, face, 6u };
+		const auto yield = reset::from_percent(T{ 1'436 } / T{ 100 });
+
+		const auto ym = yield_methodology<T>{ ANBIMA<T>{} };
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(yield_to_price(yield, b, q, ym));
+	}
+
+	BENCHMARK_TEMPLATE(yield_to_price_bill, double)->Apply(bill_maturities);
+	BENCHMARK_TEMPLATE(yield_to_price_bill, cpp_dec_float_50)->Apply(bill_maturities);
+
+	// bound at compile time
+	template<typename T>
+	static void yield_to_price_bill_static(benchmark::State& state)
+	{
+		const auto face = T{ 1'000 };
+		const auto b = bill<T>{ settlement_date, bill_maturity(state), anbima_calendar(), face };
+		const auto q = quote<T>{ settlement_date, face, 6u };
+		const auto yield = reset::from_percent(T{ 1'436 } / T{ 100 });
+
+		const auto ym = ANBIMA<T>{};
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(yield_to_price(yield, b, q, ym));
+	}
+
+	BENCHMARK_TEMPLATE(yield_to_price_bill_static, double)->Apply(bill_maturities);
+
+}
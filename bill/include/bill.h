@@ -30,6 +30,10 @@
 #include <following.h>
 #include <cash_flow.h>
 
+#include <lazy.h>
+#include <flow_block.h>
+#include <shared_calendar.h>
+
 
 namespace debt_security
 {
@@ -43,8 +47,15 @@ namespace debt_security
 		explicit bill(
 			std::chrono::year_month_day issue_date,
 			std::chrono::year_month_day maturity_date, // or should these 2 be captured as a georgian::period?
-			gregorian::calendar cal, // do we want to copy these everywhere?
+			const gregorian::calendar& cal, // interned, so equal calendars are shared rather than copied into every instrument
 			T face = 100 // do we care for this? (or is it just part of price?) if we do not have it we'll have to have cashflow to be based on a unit notional
+		);
+
+		explicit bill(
+			std::chrono::year_month_day issue_date,
+			std::chrono::year_month_day maturity_date,
+			shared_calendar cal,
+			T face = 100
 		) noexcept;
 
 	public:
@@ -52,19 +63,25 @@ namespace debt_security
 		auto get_issue_date() const noexcept -> const std::chrono::year_month_day&;
 		auto get_maturity_date() const noexcept -> const std::chrono::year_month_day&;
 		auto get_calendar() const noexcept -> const gregorian::calendar&;
+		auto get_shared_calendar() const noexcept -> const shared_calendar&;
 		auto get_face() const noexcept -> const T&;
 
 	public:
 
-		auto cash_flow() const -> fin_calendar::cash_flow<T>; // should we also return a cashflow at the issuance going the other way? (for that we'll need to capture issue price somehow)
+		auto cash_flow() const -> const fin_calendar::cash_flow<T>&; // should we also return a cashflow at the issuance going the other way? (for that we'll need to capture issue price somehow)
+
+		auto flow_block() const -> const debt_security::flow_block<T>&; // the same flow, for pricing loops
 
 	private:
 
 		std::chrono::year_month_day issue_date_{};
 		std::chrono::year_month_day maturity_date_{};
-		gregorian::calendar cal_{};
+		shared_calendar cal_{};
 		T face_{};
 
+		lazy<fin_calendar::cash_flow<T>> cash_flow_{};
+		lazy<debt_security::flow_block<T>> flow_block_{};
+
 	};
 
 
@@ -72,7 +89,23 @@ namespace debt_security
 	bill<T>::bill(
 		std::chrono::year_month_day issue_date,
 		std::chrono::year_month_day maturity_date,
-		gregorian::calendar cal,
+		const gregorian::calendar& cal,
+		T face
+	) :
+		bill{
+			std::move(issue_date),
+			std::move(maturity_date),
+			intern_calendar(cal),
+			std::move(face)
+		}
+	{
+	}
+
+	template<typename T>
+	bill<T>::bill(
+		std::chrono::year_month_day issue_date,
+		std::chrono::year_month_day maturity_date,
+		shared_calendar cal,
 		T face
 	) noexcept :
 		issue_date_{ std::move(issue_date) },
@@ -97,6 +130,12 @@ namespace debt_security
 
 	template<typename T>
 	auto bill<T>::get_calendar() const noexcept -> const gregorian::calendar&
+	{
+		return *cal_;
+	}
+
+	template<typename T>
+	auto bill<T>::get_shared_calendar() const noexcept -> const shared_calendar&
 	{
 		return cal_;
 	}
@@ -109,13 +148,24 @@ namespace debt_security
 
 
 	template<typename T>
-	auto bill<T>::cash_flow() const -> fin_calendar::cash_flow<T> // do we want to cache this? (and return a const reference?)
+	auto bill<T>::cash_flow() const -> const fin_calendar::cash_flow<T>&
 	{
-		constexpr auto f = fin_calendar::following{};
+		return cash_flow_.get(
+			[this]
+			{
+				constexpr auto f = fin_calendar::following{};
+
+				const auto payment_date = f.adjust(maturity_date_, *cal_);
 
-		const auto payment_date = f.adjust(maturity_date_, cal_);
+				return fin_calendar::cash_flow<T>{ payment_date, face_ };
+			}
+		);
+	}
 
-		return fin_calendar::cash_flow<T>{ payment_date, face_ };
+	template<typename T>
+	auto bill<T>::flow_block() const -> const debt_security::flow_block<T>&
+	{
+		return flow_block_.get([this] { return debt_security::flow_block<T>{ cash_flow() }; });
 	}
 
 }
@@ -50,6 +50,19 @@ namespace debt_security
 		EXPECT_EQ(b.get_face(), face);
 	}
 
+	TEST(bill, constructor2)
+	{
+		const auto issue_date = 2025y / January / 1d;
+		const auto maturity_date = 2025y / February / 1d;
+		const auto calendar = intern_calendar(locate_calendar("America/ANBIMA"s));
+		const auto face = 1'000.0;
+		const auto b1 = bill{ issue_date, maturity_date, calendar, face };
+		const auto b2 = bill{ issue_date, maturity_date, *calendar, face };
+
+		EXPECT_EQ(b1.get_shared_calendar(), calendar);
+		EXPECT_EQ(b2.get_shared_calendar(), calendar); // equal calendars are shared
+	}
+
 	TEST(bill, cash_flow1)
 	{
 		const auto issue_date = 2025y / January / 1d;
@@ -64,4 +77,36 @@ namespace debt_security
 		EXPECT_EQ(cf.get_amount(), face);
 	}
 
+	TEST(bill, cash_flow2)
+	{
+		const auto issue_date = 2025y / January / 1d;
+		const auto maturity_date = 2025y / February / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto b = bill{ issue_date, maturity_date, calendar, face };
+
+		const auto& cf1 = b.cash_flow();
+		const auto& cf2 = b.cash_flow();
+
+		EXPECT_EQ(&cf1, &cf2); // computed once
+
+		const auto c = b;
+		EXPECT_EQ(c.cash_flow().get_payment_date(), cf1.get_payment_date());
+	}
+
+	TEST(bill, flow_block1)
+	{
+		const auto issue_date = 2025y / January / 1d;
+		const auto maturity_date = 2025y / February / 1d; // Saturday
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto b = bill{ issue_date, maturity_date, calendar, face };
+
+		const auto& block = b.flow_block();
+		ASSERT_EQ(block.size(), 1uz);
+		EXPECT_EQ(from_serial_day(block.get_payment_days()[0]), b.cash_flow().get_payment_date());
+		EXPECT_EQ(block.get_amounts()[0], face);
+		EXPECT_EQ(&block, &b.flow_block());
+	}
+
 }
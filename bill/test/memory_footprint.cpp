@@ -0,0 +1,107 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <bill.h>
+
+#include <static_data.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+using namespace std;
+using namespace std::chrono;
+using namespace gregorian::static_data;
+
+
+// count heap allocations, so we can see what instruments really cost
+static auto allocated = atomic<size_t>{ 0 };
+
+auto operator new(size_t size) -> void*
+{
+	allocated += size;
+	if (auto p = malloc(size == 0 ? 1 : size))
+		return p;
+	throw bad_alloc{};
+}
+
+auto operator delete(void* p) noexcept -> void
+{
+	free(p);
+}
+
+auto operator delete(void* p, size_t) noexcept -> void
+{
+	free(p);
+}
+
+
+namespace debt_security
+{
+
+	TEST(bill, memory_footprint1)
+	{
+		constexpr auto number_of_bills = 100'000uz;
+
+		const auto issue_date = 2025y / January / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+
+		const auto warm_up = bill{ issue_date, 2025y / February / 1d, calendar, face }; // interns the calendar
+
+		// what every bill used to carry with it
+		const auto before_copy = allocated.load();
+		const auto copy = calendar;
+		const auto calendar_copy_bytes = allocated.load() - before_copy;
+		const auto copied_bytes_per_bill = sizeof(gregorian::calendar) + calendar_copy_bytes;
+
+		auto bills = vector<bill<double>>{};
+		bills.reserve(number_of_bills);
+
+		const auto before_bills = allocated.load();
+		for (auto i = 0uz; i < number_of_bills; ++i)
+		{
+			const auto maturity_date = year_month_day{ sys_days{ issue_date } + days{ i + 1 } };
+			bills.emplace_back(issue_date, maturity_date, calendar, face);
+		}
+		const auto bills_heap_bytes = allocated.load() - before_bills;
+
+		for (const auto& b : bills)
+			EXPECT_EQ(&b.get_calendar(), &warm_up.get_calendar()); // all share one calendar
+
+		EXPECT_EQ(bills_heap_bytes, 0uz); // no calendar copies on the heap
+
+		const auto shared_footprint = number_of_bills * sizeof(bill<double>) + bills_heap_bytes;
+		const auto copied_footprint = number_of_bills * (sizeof(bill<double>) - sizeof(shared_calendar) + copied_bytes_per_bill);
+
+		RecordProperty("shared_footprint", to_string(shared_footprint));
+		RecordProperty("copied_footprint", to_string(copied_footprint));
+
+		EXPECT_LT(shared_footprint, copied_footprint);
+	}
+
+}
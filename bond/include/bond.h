@@ -25,7 +25,6 @@
 #include <chrono>
 #include <utility>
 #include <vector>
-#include <ranges>
 #include <optional>
 
 #include <resets_math.h>
@@ -35,12 +34,29 @@
 #include <following.h>
 #include <cash_flow.h>
 #include <frequency.h>
-#include <quasi_coupon_schedule.h>
+
+#include <lazy.h>
+#include <cash_flows.h>
+#include <flow_block.h>
+#include <shared_calendar.h>
+
+#include "coupon_schedule.h"
+#include "bond_flow_view.h"
 
 
 namespace debt_security
 {
 
+	// coupon paid each period by a bond with these terms, as in bond::cash_flow
+	template<typename T = double>
+	auto bond_coupon_amount(
+		const T& face,
+		const T& coupon,
+		fin_calendar::frequency frequency,
+		const std::optional<unsigned int>& round_flows
+	) -> T;
+
+
 	template<typename T = double>
 	class bond // how bill and bond are related? (is bill a bond?) 
 	{
@@ -52,9 +68,19 @@ namespace debt_security
 			std::chrono::year_month_day maturity_date, // or should these 2 be captured as a georgian::period?
 			fin_calendar::frequency frequency,
 			T coupon,
-			gregorian::calendar cal, // do we want to copy these everywhere?
+			const gregorian::calendar& cal, // interned, so equal calendars are shared rather than copied into every instrument
 			T face = 100, // do we care for this? (or is it just part of price?) if we do not have it we'll have to have cashflow to be based on a unit notional
 			std::optional<unsigned int> round_flows = std::nullopt
+		);
+
+		explicit bond(
+			std::chrono::year_month_day issue_date,
+			std::chrono::year_month_day maturity_date,
+			fin_calendar::frequency frequency,
+			T coupon,
+			shared_calendar cal,
+			T face = 100,
+			std::optional<unsigned int> round_flows = std::nullopt
 		) noexcept;
 
 	public:
@@ -64,17 +90,29 @@ namespace debt_security
 		auto get_frequency() const noexcept -> const fin_calendar::frequency&;
 		auto get_coupon() const noexcept -> const T&;
 		auto get_calendar() const noexcept -> const gregorian::calendar&;
+		auto get_shared_calendar() const noexcept -> const shared_calendar&;
 		auto get_face() const noexcept -> const T&;
 		auto get_round_flows() const noexcept -> const std::optional<unsigned int>&;
 
 	public:
 
-		auto coupon_schedule() const -> gregorian::schedule;
+		auto coupon_schedule() const -> const debt_security::coupon_schedule&;
 		// this includes all start and end dates
 
-		auto cash_flow() const -> std::vector<fin_calendar::cash_flow<T>>; // should we also return a cashflow at the issuance going the other way? (for that we'll need to capture issue price somehow)
-		// is vector a correct container to capture the flows?
-		// probably something like flat_multiset would be better, but we do not have it yet
+		auto cash_flow() const -> const cash_flows<T>&; // should we also return a cashflow at the issuance going the other way? (for that we'll need to capture issue price somehow)
+		// the final coupon and the principal are a single flow
+
+		auto flow_block() const -> const debt_security::flow_block<T>&; // the same flows, for pricing loops
+
+		auto flows() const -> bond_flow_view<T>; // the same flows again, but worked out one at a time (nothing is materialised)
+		auto flows_after(const std::chrono::year_month_day& settlement_date) const -> bond_flow_view<T>; // only those paid after settlement
+
+	private:
+
+		auto _terms() const -> const bond_terms<T>&;
+		auto _coupon_amount() const -> T;
+
+		auto _make_cash_flow() const -> cash_flows<T>;
 
 	private:
 
@@ -82,20 +120,66 @@ namespace debt_security
 		std::chrono::year_month_day maturity_date_{};
 		fin_calendar::frequency frequency_{};
 		T coupon_{};
-		gregorian::calendar cal_{};
+		shared_calendar cal_{};
 		T face_{};
 		std::optional<unsigned int> round_flows_{};
 
+		lazy<debt_security::coupon_schedule> coupon_schedule_{};
+		lazy<cash_flows<T>> cash_flow_{};
+		lazy<debt_security::flow_block<T>> flow_block_{};
+		lazy<bond_terms<T>> terms_{};
+
 	};
 
 
+	template<typename T>
+	auto bond_coupon_amount(
+		const T& face,
+		const T& coupon, // as quoted on the market, as in bond
+		fin_calendar::frequency frequency,
+		const std::optional<unsigned int>& round_flows
+	) -> T
+	{
+		const auto one = T{ 1 }; // constexpr would be better, but cpp_dec_float_50 does not support it
+		const auto period_fraction = T{ one / static_cast<T>(coupons_per_year(frequency)) }; // exact in double for Annual, SemiAnnual and Quarterly, but not for Monthly (1/12)
+		const auto coupon_amount_raw =
+			T{ face * (pow(one + reset::from_percent(coupon), period_fraction) - one) };
+		// also need to handle non-Brazil bonds and non-standard periods
+		return round_flows ?
+			T{ reset::round_dp(coupon_amount_raw, *round_flows) } :
+			coupon_amount_raw;
+	}
+
+
 	template<typename T>
 	bond<T>::bond(
 		std::chrono::year_month_day issue_date,
 		std::chrono::year_month_day maturity_date,
 		fin_calendar::frequency frequency,
 		T coupon, // as quoted on the market so 10% is passed in as 10.0 - have not decided yet if is a good idea, or not
-		gregorian::calendar cal,
+		const gregorian::calendar& cal,
+		T face,
+		std::optional<unsigned int> round_flows
+	) :
+		bond{
+			std::move(issue_date),
+			std::move(maturity_date),
+			std::move(frequency),
+			std::move(coupon),
+			intern_calendar(cal),
+			std::move(face),
+			std::move(round_flows)
+		}
+	{
+	}
+
+	template<typename T>
+	bond<T>::bond(
+		std::chrono::year_month_day issue_date,
+		std::chrono::year_month_day maturity_date,
+		fin_calendar::frequency frequency,
+		T coupon,
+		shared_calendar cal,
 		T face,
 		std::optional<unsigned int> round_flows
 	) noexcept :
@@ -136,6 +220,12 @@ namespace debt_security
 
 	template<typename T>
 	auto bond<T>::get_calendar() const noexcept -> const gregorian::calendar&
+	{
+		return *cal_;
+	}
+
+	template<typename T>
+	auto bond<T>::get_shared_calendar() const noexcept -> const shared_calendar&
 	{
 		return cal_;
 	}
@@ -154,43 +244,55 @@ namespace debt_security
 
 
 	template<typename T>
-	auto bond<T>::coupon_schedule() const -> gregorian::schedule // do we want to cache this? (and return a const reference?)
+	auto bond<T>::coupon_schedule() const -> const debt_security::coupon_schedule&
 	{
-		return fin_calendar::make_quasi_coupon_schedule(
-			gregorian::util::days_period{ issue_date_, maturity_date_ },
-			fin_calendar::duration_variant{ std::chrono::months{ 6 } }, // test only
-			issue_date_ // test only
-		);
+		return coupon_schedule_.get([this] { return debt_security::coupon_schedule{ issue_date_, maturity_date_, frequency_ }; });
 	}
 
 
 	// should it be called cash_flows? (ot just flows?)
 	template<typename T>
-	auto bond<T>::cash_flow() const -> std::vector<fin_calendar::cash_flow<T>> // do we want to cache this? (and return a const reference?)
+	auto bond<T>::cash_flow() const -> const cash_flows<T>&
 	{
-		auto result = std::vector<fin_calendar::cash_flow<T>>{};
+		return cash_flow_.get([this] { return _make_cash_flow(); });
+	}
 
-		constexpr auto f = fin_calendar::following{};
+	template<typename T>
+	auto bond<T>::flow_block() const -> const debt_security::flow_block<T>&
+	{
+		return flow_block_.get([this] { return debt_security::flow_block<T>{ cash_flow() }; });
+	}
 
-		const auto one = T{ 1 }; // constexpr would be better, but cpp_dec_float_50 does not support it
-		const auto coupon_amount_raw =
-			face_ * (pow(one + reset::from_percent(coupon_), 0.5) - one); // test only - should be based on the coupon rate and frequency // what about the type of the second argument of pow?
-		// also need to handle non-Brazil bonds and non-standard periods
-		const auto coupon_amount = round_flows_ ?
-			reset::round_dp(coupon_amount_raw, *round_flows_) :
-			coupon_amount_raw;
+	template<typename T>
+	auto bond<T>::flows() const -> bond_flow_view<T>
+	{
+		return bond_flow_view<T>{ _terms() };
+	}
 
-		const auto dates = coupon_schedule().get_dates(); // I am sure that std::set is not what we want here
-		for (const auto& end_date : dates | std::views::drop(1)) // we drop the first date as it is a start date
-		{
-			const auto coupon_payment_date = f.adjust(end_date, cal_); // this must be more elegant with ranges
-			result.emplace_back(coupon_payment_date, coupon_amount);
-		}
+	template<typename T>
+	auto bond<T>::flows_after(const std::chrono::year_month_day& settlement_date) const -> bond_flow_view<T>
+	{
+		return flows().flows_after(settlement_date);
+	}
 
-		const auto principal_payment_date = f.adjust(maturity_date_, cal_); // need a more consistent name?
-		result.emplace_back(principal_payment_date, face_); // at the moment we handle the coupon and principal payment separately, so we have multiple entries for the same date
+	template<typename T>
+	auto bond<T>::_terms() const -> const bond_terms<T>&
+	{
+		return terms_.get([this] { return bond_terms<T>{ issue_date_, maturity_date_, frequency_, *cal_, _coupon_amount(), face_ }; });
+	}
+
+	template<typename T>
+	auto bond<T>::_coupon_amount() const -> T
+	{
+		return bond_coupon_amount(face_, coupon_, frequency_, round_flows_);
+	}
+
+	template<typename T>
+	auto bond<T>::_make_cash_flow() const -> cash_flows<T>
+	{
+		const auto view = flows();
 
-		return result;
+		return cash_flows<T>{ std::vector<fin_calendar::cash_flow<T>>{ view.begin(), view.end() } };
 	}
 
 }
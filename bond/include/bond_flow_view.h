@@ -0,0 +1,315 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <algorithm>
+#include <utility>
+
+#include <calendar.h>
+
+#include <following.h>
+#include <cash_flow.h>
+#include <frequency.h>
+
+#include "coupon_schedule.h"
+
+
+namespace debt_security
+{
+
+	// what the flows of a bond are worked out from
+	// (the calendar is not owned, so the terms are kept by the bond they came from)
+	template<typename T = double>
+	class bond_terms final
+	{
+
+	public:
+
+		explicit bond_terms(
+			const std::chrono::year_month_day& issue_date,
+			const std::chrono::year_month_day& maturity_date,
+			const fin_calendar::frequency& frequency,
+			const gregorian::calendar& cal,
+			T coupon_amount,
+			T face
+		);
+
+	public:
+
+		auto coupons() const noexcept -> std::size_t;
+
+		// the principal is paid together with the final coupon (as in bond::cash_flow)
+		auto flow(std::size_t coupon) const -> fin_calendar::cash_flow<T>;
+
+	private:
+
+		std::chrono::year_month_day maturity_date_;
+		fin_calendar::frequency frequency_;
+		const gregorian::calendar* cal_;
+		T coupon_amount_;
+		T face_;
+		std::size_t coupons_;
+
+	};
+
+
+	// flows of a bond worked out on demand, one coupon at a time (so no allocation, and random access)
+	// (iterators only refer to the terms, so they stay valid after the view is gone - as long as the bond is there)
+	template<typename T = double>
+	class bond_flow_view final : public std::ranges::view_interface<bond_flow_view<T>>
+	{
+
+	public:
+
+		class iterator;
+
+	public:
+
+		bond_flow_view() noexcept = default;
+
+		explicit bond_flow_view(const bond_terms<T>& terms) noexcept;
+
+	public:
+
+		auto begin() const noexcept -> iterator;
+		auto end() const noexcept -> iterator;
+
+		auto size() const noexcept -> std::size_t;
+
+		// flows paid after the settlement date (a binary search over the coupons, so O(log n) date adjustments)
+		auto flows_after(const std::chrono::year_month_day& settlement_date) const -> bond_flow_view;
+
+	private:
+
+		const bond_terms<T>* terms_{ nullptr };
+		std::size_t first_{ 0uz }; // the first coupon in the view
+		std::size_t last_{ 0uz }; // one past the last coupon in the view
+
+	};
+
+
+	template<typename T>
+	class bond_flow_view<T>::iterator final
+	{
+
+	public:
+
+		using iterator_concept = std::random_access_iterator_tag;
+		using iterator_category = std::input_iterator_tag; // flows are made on the fly, so there is no reference to them
+		using value_type = fin_calendar::cash_flow<T>;
+		using difference_type = std::ptrdiff_t;
+
+	public:
+
+		iterator() noexcept = default;
+
+		explicit iterator(const bond_terms<T>* terms, std::size_t coupon) noexcept;
+
+	public:
+
+		auto operator*() const -> value_type;
+		auto operator[](difference_type n) const -> value_type;
+
+		auto operator++() noexcept -> iterator&;
+		auto operator++(int) noexcept -> iterator;
+		auto operator--() noexcept -> iterator&;
+		auto operator--(int) noexcept -> iterator;
+
+		auto operator+=(difference_type n) noexcept -> iterator&;
+		auto operator-=(difference_type n) noexcept -> iterator&;
+
+		friend auto operator+(iterator i, difference_type n) noexcept -> iterator { return i += n; }
+		friend auto operator+(difference_type n, iterator i) noexcept -> iterator { return i += n; }
+		friend auto operator-(iterator i, difference_type n) noexcept -> iterator { return i -= n; }
+		friend auto operator-(const iterator& x, const iterator& y) noexcept -> difference_type
+		{
+			return static_cast<difference_type>(x.coupon_) - static_cast<difference_type>(y.coupon_);
+		}
+
+		friend auto operator==(const iterator& x, const iterator& y) noexcept -> bool { return x.coupon_ == y.coupon_; }
+		friend auto operator<=>(const iterator& x, const iterator& y) noexcept { return x.coupon_ <=> y.coupon_; }
+
+	private:
+
+		const bond_terms<T>* terms_{ nullptr };
+		std::size_t coupon_{ 0uz };
+
+	};
+
+
+	template<typename T>
+	bond_terms<T>::bond_terms(
+		const std::chrono::year_month_day& issue_date,
+		const std::chrono::year_month_day& maturity_date,
+		const fin_calendar::frequency& frequency,
+		const gregorian::calendar& cal,
+		T coupon_amount,
+		T face
+	) :
+		maturity_date_{ maturity_date },
+		frequency_{ frequency },
+		cal_{ &cal },
+		coupon_amount_{ std::move(coupon_amount) },
+		face_{ std::move(face) },
+		coupons_{ coupon_schedule_size(issue_date, maturity_date, frequency) - 1uz } // the issue date is not a payment
+	{
+	}
+
+
+	template<typename T>
+	auto bond_terms<T>::coupons() const noexcept -> std::size_t
+	{
+		return coupons_;
+	}
+
+
+	template<typename T>
+	auto bond_terms<T>::flow(std::size_t coupon) const -> fin_calendar::cash_flow<T>
+	{
+		constexpr auto f = fin_calendar::following{};
+
+		const auto end_date = coupon_date(maturity_date_, frequency_, static_cast<int>(coupons_ - 1uz - coupon));
+		const auto payment_date = f.adjust(end_date, *cal_);
+
+		if (coupon + 1uz == coupons_)
+			return fin_calendar::cash_flow<T>{ payment_date, T{ coupon_amount_ + face_ } };
+		else
+			return fin_calendar::cash_flow<T>{ payment_date, coupon_amount_ };
+	}
+
+
+	template<typename T>
+	bond_flow_view<T>::bond_flow_view(const bond_terms<T>& terms) noexcept :
+		terms_{ &terms },
+		first_{ 0uz },
+		last_{ terms.coupons() }
+	{
+	}
+
+
+	template<typename T>
+	auto bond_flow_view<T>::begin() const noexcept -> iterator
+	{
+		return iterator{ terms_, first_ };
+	}
+
+	template<typename T>
+	auto bond_flow_view<T>::end() const noexcept -> iterator
+	{
+		return iterator{ terms_, last_ };
+	}
+
+	template<typename T>
+	auto bond_flow_view<T>::size() const noexcept -> std::size_t
+	{
+		return last_ - first_;
+	}
+
+
+	template<typename T>
+	auto bond_flow_view<T>::flows_after(const std::chrono::year_month_day& settlement_date) const -> bond_flow_view
+	{
+		// payment dates only go up (following adjustment keeps the order of the coupon dates)
+		const auto it = std::ranges::partition_point(
+			*this,
+			[&](const fin_calendar::cash_flow<T>& flow) { return !(settlement_date < flow.get_payment_date()); }
+		);
+
+		auto result = *this;
+		result.first_ = first_ + static_cast<std::size_t>(it - begin());
+		return result;
+	}
+
+
+	template<typename T>
+	bond_flow_view<T>::iterator::iterator(const bond_terms<T>* terms, std::size_t coupon) noexcept :
+		terms_{ terms },
+		coupon_{ coupon }
+	{
+	}
+
+	template<typename T>
+	auto bond_flow_view<T>::iterator::operator*() const -> value_type
+	{
+		return terms_->flow(coupon_);
+	}
+
+	template<typename T>
+	auto bond_flow_view<T>::iterator::operator[](difference_type n) const -> value_type
+	{
+		return *(*this + n);
+	}
+
+	template<typename T>
+	auto bond_flow_view<T>::iterator::operator++() noexcept -> iterator&
+	{
+		++coupon_;
+		return *this;
+	}
+
+	template<typename T>
+	auto bond_flow_view<T>::iterator::operator++(int) noexcept -> iterator
+	{
+		auto result = *this;
+		++coupon_;
+		return result;
+	}
+
+	template<typename T>
+	auto bond_flow_view<T>::iterator::operator--() noexcept -> iterator&
+	{
+		--coupon_;
+		return *this;
+	}
+
+	template<typename T>
+	auto bond_flow_view<T>::iterator::operator--(int) noexcept -> iterator
+	{
+		auto result = *this;
+		--coupon_;
+		return result;
+	}
+
+	template<typename T>
+	auto bond_flow_view<T>::iterator::operator+=(difference_type n) noexcept -> iterator&
+	{
+		coupon_ = static_cast<std::size_t>(static_cast<difference_type>(coupon_) + n);
+		return *this;
+	}
+
+	template<typename T>
+	auto bond_flow_view<T>::iterator::operator-=(difference_type n) noexcept -> iterator&
+	{
+		coupon_ = static_cast<std::size_t>(static_cast<difference_type>(coupon_) - n);
+		return *this;
+	}
+
+}
+
+
+template<typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<debt_security::bond_flow_view<T>> = true;
@@ -0,0 +1,177 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include <span>
+#include <stdexcept>
+
+#include <frequency.h>
+
+
+namespace debt_security
+{
+
+	// months between coupons, for the frequencies which are a whole number of months
+	constexpr auto coupon_months(const fin_calendar::frequency& frequency) -> int
+	{
+		if (frequency == fin_calendar::Annual)
+			return 12;
+		else if (frequency == fin_calendar::SemiAnnual)
+			return 6;
+		else if (frequency == fin_calendar::Quarterly)
+			return 3;
+		else if (frequency == fin_calendar::Monthly)
+			return 1;
+		else
+			throw std::invalid_argument{ "Coupon frequency must be a whole number of months" };
+	}
+
+	constexpr auto coupons_per_year(const fin_calendar::frequency& frequency) -> int
+	{
+		return 12 / coupon_months(frequency);
+	}
+
+
+	// coupon dates roll back from the maturity date (so a broken period would be the first one),
+	// and a day which does not exist in a month becomes the last day of that month
+	constexpr auto coupon_date(
+		const std::chrono::year_month_day& maturity_date,
+		const fin_calendar::frequency& frequency,
+		int periods_before_maturity
+	) -> std::chrono::year_month_day
+	{
+		const auto ym = std::chrono::year_month{ maturity_date.year(), maturity_date.month() } -
+			std::chrono::months{ periods_before_maturity * coupon_months(frequency) };
+
+		const auto result = ym / maturity_date.day();
+		return result.ok() ? result : std::chrono::year_month_day{ ym / std::chrono::last };
+	}
+
+
+	// the issue date, then the (unadjusted) coupon dates up to and including the maturity date
+	constexpr auto coupon_schedule_size(
+		const std::chrono::year_month_day& issue_date,
+		const std::chrono::year_month_day& maturity_date,
+		const fin_calendar::frequency& frequency
+	) -> std::size_t
+	{
+		if (!(issue_date < maturity_date))
+			throw std::invalid_argument{ "Maturity date must be after the issue date" };
+
+		const auto months =
+			(static_cast<int>(maturity_date.year()) - static_cast<int>(issue_date.year())) * 12 +
+			(static_cast<int>(static_cast<unsigned int>(maturity_date.month())) - static_cast<int>(static_cast<unsigned int>(issue_date.month())));
+
+		// the last coupon date after the issue date is at most this many periods before the maturity
+		auto periods = months / coupon_months(frequency);
+		while (periods > 0 && !(issue_date < coupon_date(maturity_date, frequency, periods)))
+			--periods;
+
+		return static_cast<std::size_t>(periods) + 2uz; // plus the maturity and the issue dates
+	}
+
+
+	// writes the schedule into dates (which needs at least coupon_schedule_size elements) and returns how many were written
+	constexpr auto make_coupon_schedule(
+		const std::chrono::year_month_day& issue_date,
+		const std::chrono::year_month_day& maturity_date,
+		const fin_calendar::frequency& frequency,
+		std::span<std::chrono::year_month_day> dates
+	) -> std::size_t
+	{
+		const auto size = coupon_schedule_size(issue_date, maturity_date, frequency);
+		if (dates.size() < size)
+			throw std::out_of_range{ "Not enough space for the coupon schedule" };
+
+		dates[0] = issue_date;
+		for (auto i = 1uz; i < size; ++i)
+			dates[i] = coupon_date(maturity_date, frequency, static_cast<int>(size - 1uz - i));
+
+		return size;
+	}
+
+
+	// the schedule in contiguous storage, sorted
+	class coupon_schedule final
+	{
+
+	public:
+
+		constexpr explicit coupon_schedule(
+			const std::chrono::year_month_day& issue_date,
+			const std::chrono::year_month_day& maturity_date,
+			const fin_calendar::frequency& frequency
+		);
+
+	public:
+
+		constexpr auto get_dates() const noexcept -> std::span<const std::chrono::year_month_day>;
+
+		constexpr auto size() const noexcept -> std::size_t;
+
+		// the start dates are all but the last date, the end dates are all but the first one
+		constexpr auto get_start_dates() const noexcept -> std::span<const std::chrono::year_month_day>;
+		constexpr auto get_end_dates() const noexcept -> std::span<const std::chrono::year_month_day>;
+
+	private:
+
+		std::vector<std::chrono::year_month_day> dates_;
+
+	};
+
+
+	constexpr coupon_schedule::coupon_schedule(
+		const std::chrono::year_month_day& issue_date,
+		const std::chrono::year_month_day& maturity_date,
+		const fin_calendar::frequency& frequency
+	) :
+		dates_(coupon_schedule_size(issue_date, maturity_date, frequency))
+	{
+		make_coupon_schedule(issue_date, maturity_date, frequency, dates_);
+	}
+
+
+	constexpr auto coupon_schedule::get_dates() const noexcept -> std::span<const std::chrono::year_month_day>
+	{
+		return dates_;
+	}
+
+	constexpr auto coupon_schedule::size() const noexcept -> std::size_t
+	{
+		return dates_.size();
+	}
+
+	constexpr auto coupon_schedule::get_start_dates() const noexcept -> std::span<const std::chrono::year_month_day>
+	{
+		return get_dates().first(dates_.size() - 1uz);
+	}
+
+	constexpr auto coupon_schedule::get_end_dates() const noexcept -> std::span<const std::chrono::year_month_day>
+	{
+		return get_dates().subspan(1uz);
+	}
+
+}
@@ -29,6 +29,7 @@
 #include <string>
 #include <array>
 #include <ranges>
+#include <algorithm>
 
 using namespace std;
 using namespace std::chrono;
@@ -90,7 +91,7 @@ namespace debt_security
 
 		const auto schedule = b.coupon_schedule();
 
-		const auto expected = gregorian::schedule::dates{
+		const auto expected = array{
 			2008y / January / 1d,
 			2008y / July / 1d,
 			2009y / January / 1d,
@@ -106,7 +107,7 @@ namespace debt_security
 			2014y / January / 1d
 		};
 
-		EXPECT_EQ(expected, schedule.get_dates());
+		EXPECT_TRUE(ranges::equal(expected, schedule.get_dates()));
 	}
 
 	TEST(bond, cash_flow1)
@@ -157,7 +158,10 @@ namespace debt_security
 
 				EXPECT_EQ(e, calculated);
 
-				EXPECT_EQ(48.80885, cash_flow.get_amount()); // only look at the coupons for now (final principal is an addition cash flow, which is not consideed here)
+				if (payment_date != cash_flows.back().get_payment_date())
+					EXPECT_EQ(48.80885, cash_flow.get_amount());
+				else
+					EXPECT_EQ(48.80885 + 1'000.0, cash_flow.get_amount()); // final coupon and principal together
 			}
 		}
 	}
@@ -184,7 +188,94 @@ namespace debt_security
 		const auto cf = b.cash_flow();
 
 		EXPECT_EQ(cf.back().get_payment_date(), 2014y / January / 2d);
-		EXPECT_EQ(cf.back().get_amount(), face);
+		EXPECT_EQ(cf.back().get_amount(), 48.80885 + face);
+
+		EXPECT_EQ(cf.size(), 12uz); // one flow per date
+		for (auto i = 1uz; i < cf.size(); ++i)
+			EXPECT_LT(cf[i - 1uz].get_payment_date(), cf[i].get_payment_date());
+	}
+
+	TEST(bond, cash_flow3)
+	{
+		const auto issue_date = 2008y / January / 1d;
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+		const auto b = bond{
+			issue_date,
+			maturity_date,
+			frequency,
+			coupon,
+			calendar,
+			face,
+			round_flows
+		};
+
+		const auto& cf1 = b.cash_flow();
+		const auto& cf2 = b.cash_flow();
+		EXPECT_EQ(&cf1, &cf2); // computed once
+
+		const auto& s1 = b.coupon_schedule();
+		const auto& s2 = b.coupon_schedule();
+		EXPECT_EQ(&s1, &s2);
+
+		const auto c = b;
+		EXPECT_EQ(c.cash_flow().size(), cf1.size());
+	}
+
+	TEST(bond, flow_block1)
+	{
+		const auto issue_date = 2008y / January / 1d;
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+		const auto b = bond{
+			issue_date,
+			maturity_date,
+			frequency,
+			coupon,
+			calendar,
+			face,
+			round_flows
+		};
+
+		const auto& cf = b.cash_flow();
+		const auto& block = b.flow_block();
+		ASSERT_EQ(block.size(), cf.size());
+		for (auto i = 0uz; i < block.size(); ++i)
+		{
+			EXPECT_EQ(from_serial_day(block.get_payment_days()[i]), cf[i].get_payment_date());
+			EXPECT_EQ(block.get_amounts()[i], cf[i].get_amount());
+		}
+	}
+
+	TEST(bond, cash_flow4)
+	{
+		// coupons follow the frequency
+		const auto issue_date = 2008y / January / 1d;
+		const auto maturity_date = 2011y / January / 1d;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+
+		const auto annual = bond{ issue_date, maturity_date, Annual, coupon, calendar, face, round_flows };
+		ASSERT_EQ(annual.cash_flow().size(), 3uz);
+		EXPECT_EQ(annual.cash_flow().front().get_amount(), 100.0);
+
+		const auto quarterly = bond{ issue_date, maturity_date, Quarterly, coupon, calendar, face, round_flows };
+		ASSERT_EQ(quarterly.cash_flow().size(), 12uz);
+		EXPECT_EQ(quarterly.cash_flow().front().get_amount(), 24.11369);
+
+		const auto monthly = bond{ issue_date, maturity_date, Monthly, coupon, calendar, face, round_flows };
+		ASSERT_EQ(monthly.cash_flow().size(), 36uz);
+		EXPECT_EQ(monthly.cash_flow().front().get_amount(), 7.97414);
 	}
 
 }
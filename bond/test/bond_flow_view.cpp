@@ -0,0 +1,141 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <bond_flow_view.h>
+#include <bond.h>
+
+#include <static_data.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <ranges>
+#include <algorithm>
+
+using namespace std;
+using namespace std::chrono;
+using namespace gregorian;
+using namespace fin_calendar;
+using namespace gregorian::static_data;
+
+
+namespace debt_security
+{
+
+	static_assert(ranges::random_access_range<bond_flow_view<double>>);
+	static_assert(ranges::view<bond_flow_view<double>>);
+	static_assert(ranges::borrowed_range<bond_flow_view<double>>);
+
+
+	static auto _make_bond() -> bond<double>
+	{
+		const auto issue_date = 2008y / January / 1d;
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+
+		return bond{
+			issue_date,
+			maturity_date,
+			frequency,
+			coupon,
+			calendar,
+			face,
+			round_flows
+		};
+	}
+
+
+	TEST(bond_flow_view, flows1)
+	{
+		const auto b = _make_bond();
+
+		const auto flows = b.flows();
+		const auto& cash_flows = b.cash_flow();
+
+		EXPECT_EQ(flows.size(), 12uz);
+		EXPECT_EQ(flows.size(), cash_flows.size());
+		for (auto i = 0uz; i < flows.size(); ++i)
+		{
+			EXPECT_EQ(flows[i].get_payment_date(), cash_flows[i].get_payment_date());
+			EXPECT_EQ(flows[i].get_amount(), cash_flows[i].get_amount());
+		}
+
+		EXPECT_EQ(flows.front().get_payment_date(), 2008y / July / 1d);
+		EXPECT_EQ(flows.front().get_amount(), 48.80885);
+		EXPECT_EQ(flows.back().get_payment_date(), 2014y / January / 2d);
+		EXPECT_EQ(flows.back().get_amount(), 48.80885 + 1'000.0);
+	}
+
+	TEST(bond_flow_view, flows_after1)
+	{
+		const auto b = _make_bond();
+
+		EXPECT_EQ(b.flows_after(2008y / May / 21d).size(), 12uz);
+		EXPECT_EQ(b.flows_after(2007y / December / 31d).size(), 12uz);
+
+		const auto next = b.flows_after(2010y / May / 21d);
+		EXPECT_EQ(next.size(), 8uz);
+		EXPECT_EQ(next.front().get_payment_date(), 2010y / July / 1d);
+		EXPECT_EQ(next.back().get_payment_date(), 2014y / January / 2d);
+	}
+
+	TEST(bond_flow_view, flows_after2)
+	{
+		const auto b = _make_bond();
+
+		// a flow paid on the settlement date is not included
+		const auto flows = b.flows_after(2010y / July / 1d);
+		EXPECT_EQ(flows.size(), 7uz);
+		EXPECT_EQ(flows.front().get_payment_date(), 2011y / January / 3d);
+
+		EXPECT_TRUE(b.flows_after(2014y / January / 2d).empty());
+		EXPECT_TRUE(b.flows_after(2020y / January / 1d).empty());
+	}
+
+	TEST(bond_flow_view, flows_after3)
+	{
+		const auto b = _make_bond();
+
+		// seeking again from a seek gives the same as seeking once
+		const auto once = b.flows_after(2012y / March / 1d);
+		const auto twice = b.flows_after(2009y / March / 1d).flows_after(2012y / March / 1d);
+
+		EXPECT_TRUE(ranges::equal(once, twice, {}, &cash_flow<double>::get_payment_date, &cash_flow<double>::get_payment_date));
+	}
+
+	TEST(bond_flow_view, iterator1)
+	{
+		const auto b = _make_bond();
+
+		// iterators refer to the bond, not to the view they came from
+		const auto it = b.flows().begin();
+
+		EXPECT_EQ((*it).get_payment_date(), 2008y / July / 1d);
+		EXPECT_EQ(it[11].get_amount(), 48.80885 + 1'000.0);
+		EXPECT_EQ(ranges::distance(it, b.flows().end()), 12);
+	}
+
+}
@@ -0,0 +1,115 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <coupon_schedule.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <array>
+#include <ranges>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+using namespace std::chrono;
+using namespace fin_calendar;
+
+
+namespace debt_security
+{
+
+	TEST(coupon_schedule, coupon_months1)
+	{
+		EXPECT_EQ(coupon_months(Annual), 12);
+		EXPECT_EQ(coupon_months(SemiAnnual), 6);
+		EXPECT_EQ(coupon_months(Quarterly), 3);
+		EXPECT_EQ(coupon_months(Monthly), 1);
+		EXPECT_EQ(coupons_per_year(SemiAnnual), 2);
+
+		EXPECT_THROW(coupon_months(Daily), invalid_argument);
+	}
+
+	TEST(coupon_schedule, make_coupon_schedule1)
+	{
+		// at compile time, into a buffer of the right size
+		constexpr auto issue_date = 2008y / January / 1d;
+		constexpr auto maturity_date = 2014y / January / 1d;
+		constexpr auto size = coupon_schedule_size(issue_date, maturity_date, SemiAnnual);
+		static_assert(size == 13uz);
+
+		constexpr auto dates = [=]
+		{
+			auto result = array<year_month_day, size>{};
+			make_coupon_schedule(issue_date, maturity_date, SemiAnnual, result);
+			return result;
+		}();
+		static_assert(dates.front() == issue_date);
+		static_assert(dates[1] == 2008y / July / 1d);
+		static_assert(dates.back() == maturity_date);
+
+		static_assert(coupon_schedule{ issue_date, maturity_date, Annual }.size() == 7uz);
+	}
+
+	TEST(coupon_schedule, coupon_schedule1)
+	{
+		// a broken first period, as the dates roll back from the maturity
+		const auto schedule = coupon_schedule{ 2008y / May / 21d, 2010y / January / 1d, SemiAnnual };
+
+		const auto expected = array{
+			2008y / May / 21d,
+			2008y / July / 1d,
+			2009y / January / 1d,
+			2009y / July / 1d,
+			2010y / January / 1d
+		};
+
+		EXPECT_TRUE(ranges::equal(expected, schedule.get_dates()));
+		EXPECT_TRUE(ranges::equal(span{ expected }.first(4), schedule.get_start_dates()));
+		EXPECT_TRUE(ranges::equal(span{ expected }.subspan(1), schedule.get_end_dates()));
+	}
+
+	TEST(coupon_schedule, coupon_schedule2)
+	{
+		// days which some months do not have
+		const auto schedule = coupon_schedule{ 2024y / January / 15d, 2024y / August / 31d, Quarterly };
+
+		const auto expected = array{
+			2024y / January / 15d,
+			year_month_day{ 2024y / February / last },
+			2024y / May / 31d,
+			2024y / August / 31d
+		};
+
+		EXPECT_TRUE(ranges::equal(expected, schedule.get_dates()));
+	}
+
+	TEST(coupon_schedule, coupon_schedule3)
+	{
+		EXPECT_THROW(coupon_schedule(2010y / January / 1d, 2010y / January / 1d, SemiAnnual), invalid_argument);
+
+		auto dates = array<year_month_day, 2>{};
+		EXPECT_THROW(make_coupon_schedule(2008y / January / 1d, 2009y / January / 1d, SemiAnnual, dates), out_of_range);
+		EXPECT_EQ(make_coupon_schedule(2008y / January / 1d, 2009y / January / 1d, Annual, dates), 2uz);
+	}
+
+}
@@ -0,0 +1,254 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <utility>
+#include <stdexcept>
+
+#include <period.h>
+#include <calendar.h>
+
+#include <shared_calendar.h>
+
+
+namespace debt_security
+{
+
+	class business_day_index final // should this live in the calendar project?
+	{
+
+	public:
+
+		explicit business_day_index(
+			const gregorian::calendar& cal,
+			gregorian::util::days_period period
+		);
+
+	public:
+
+		auto get_period() const noexcept -> const gregorian::util::days_period&;
+
+		auto contains(const gregorian::util::days_period& period) const noexcept -> bool;
+
+	public:
+
+		// number of business days from the start of the index up to (but excluding) the given day
+		auto ordinal(const std::chrono::sys_days& day) const -> std::int32_t;
+		auto ordinal(std::int32_t serial_day) const -> std::int32_t; // days since 1970-01-01
+
+		// number of business days in [start, end) - this is what the 252 day count needs
+		// (negative if end is before start)
+		auto business_days(
+			const std::chrono::sys_days& start,
+			const std::chrono::sys_days& end
+		) const -> std::int32_t;
+
+		auto business_days(
+			std::int32_t start,
+			std::int32_t end
+		) const -> std::int32_t;
+
+		// both ends are included, the same as gregorian::calendar::count_business_days
+		auto count_business_days(const gregorian::util::days_period& period) const -> std::size_t;
+
+	private:
+
+		gregorian::util::days_period period_;
+		std::chrono::sys_days front_{};
+		std::int32_t front_serial_day_{};
+		std::vector<std::int32_t> ordinals_{}; // one per serial day in the period, plus one past the end
+
+	};
+
+
+	inline business_day_index::business_day_index(
+		const gregorian::calendar& cal,
+		gregorian::util::days_period period
+	) :
+		period_{ std::move(period) },
+		front_{ period_.get_from() },
+		front_serial_day_{ static_cast<std::int32_t>(front_.time_since_epoch().count()) }
+	{
+		const auto back = std::chrono::sys_days{ period_.get_until() };
+		if (back < front_)
+			throw std::out_of_range{ "Business day index period is empty" };
+
+		const auto size = static_cast<std::size_t>((back - front_).count()) + 1uz;
+		ordinals_.reserve(size + 1uz);
+
+		auto n = std::int32_t{ 0 };
+		ordinals_.push_back(n);
+		for (auto d = front_; d <= back; d += std::chrono::days{ 1 })
+		{
+			if (cal.is_business_day(d))
+				++n;
+			ordinals_.push_back(n);
+		}
+	}
+
+
+	inline auto business_day_index::get_period() const noexcept -> const gregorian::util::days_period&
+	{
+		return period_;
+	}
+
+	inline auto business_day_index::contains(const gregorian::util::days_period& period) const noexcept -> bool
+	{
+		return
+			period_.get_from() <= period.get_from() &&
+			period.get_until() <= period_.get_until();
+	}
+
+
+	inline auto business_day_index::ordinal(const std::chrono::sys_days& day) const -> std::int32_t
+	{
+		return ordinal(static_cast<std::int32_t>(day.time_since_epoch().count()));
+	}
+
+	inline auto business_day_index::ordinal(std::int32_t serial_day) const -> std::int32_t
+	{
+		const auto i = std::int64_t{ serial_day } - front_serial_day_;
+		if (i < 0 || static_cast<std::size_t>(i) >= ordinals_.size()) // one past the end is fine (that is what [start, end) needs)
+			throw std::out_of_range{ "Day is outside of the business day index" };
+
+		return ordinals_[static_cast<std::size_t>(i)];
+	}
+
+	inline auto business_day_index::business_days(
+		const std::chrono::sys_days& start,
+		const std::chrono::sys_days& end
+	) const -> std::int32_t
+	{
+		return ordinal(end) - ordinal(start);
+	}
+
+	inline auto business_day_index::business_days(
+		std::int32_t start,
+		std::int32_t end
+	) const -> std::int32_t
+	{
+		return ordinal(end) - ordinal(start);
+	}
+
+	inline auto business_day_index::count_business_days(const gregorian::util::days_period& period) const -> std::size_t
+	{
+		const auto from = std::chrono::sys_days{ period.get_from() };
+		const auto until = std::chrono::sys_days{ period.get_until() };
+
+		return static_cast<std::size_t>(business_days(from, until + std::chrono::days{ 1 }));
+	}
+
+
+	namespace _business_day_index
+	{
+
+		// an immutable list of indices - a new one is published each time an index is added or grown
+		// (old ones are kept, as readers might still be looking at them)
+		using indices = std::vector<std::pair<shared_calendar, std::shared_ptr<const business_day_index>>>;
+
+		inline auto find(const indices& ind, const gregorian::calendar& cal) -> indices::const_iterator
+		{
+			// instruments hold interned calendars, so comparing addresses usually finds the index
+			auto it = std::ranges::find_if(ind, [&](const auto& i) { return i.first.get() == &cal; });
+			if (it == ind.cend())
+				it = std::ranges::find_if(ind, [&](const auto& i) { return *i.first == cal; });
+			return it;
+		}
+
+	}
+
+
+	// indices are shared between all users of the same calendar
+	// (the period covered grows to whole years as needed, so repeated requests do not rebuild it)
+	// only adding or growing an index takes a lock, finding one does not
+	inline auto locate_business_day_index(
+		const gregorian::calendar& cal,
+		const gregorian::util::days_period& period
+	) -> std::shared_ptr<const business_day_index>
+	{
+		static auto mutex = std::mutex{};
+		static auto published = std::vector<std::unique_ptr<const _business_day_index::indices>>{}; // guarded by the mutex
+		static auto current = std::atomic<const _business_day_index::indices*>{ nullptr };
+
+		if (const auto ind = current.load(std::memory_order_acquire))
+		{
+			const auto it = _business_day_index::find(*ind, cal);
+			if (it != ind->cend() && it->second->contains(period))
+				return it->second;
+		}
+
+		const auto lock = std::lock_guard{ mutex };
+
+		// another thread might have added the index while we were waiting
+		auto ind = published.empty() ? _business_day_index::indices{} : *published.back();
+		const auto found = _business_day_index::find(ind, cal);
+		if (found != ind.cend() && found->second->contains(period))
+			return found->second;
+
+		auto from = period.get_from();
+		auto until = period.get_until();
+		if (found != ind.cend())
+		{
+			from = std::min(from, found->second->get_period().get_from());
+			until = std::max(until, found->second->get_period().get_until());
+		}
+
+		auto index = std::shared_ptr<const business_day_index>{};
+		try
+		{
+			index = std::make_shared<const business_day_index>(
+				cal,
+				gregorian::util::days_period{
+					from.year() / std::chrono::January / std::chrono::day{ 1 },
+					until.year() / std::chrono::December / std::chrono::day{ 31 }
+				}
+			);
+		}
+		catch (const std::out_of_range&) // whole years might not be covered by the calendar
+		{
+			index = std::make_shared<const business_day_index>(
+				cal,
+				gregorian::util::days_period{ from, until }
+			);
+		}
+
+		if (found != ind.cend())
+			ind[static_cast<std::size_t>(found - ind.cbegin())].second = index;
+		else
+			ind.emplace_back(intern_calendar(cal), index);
+
+		published.push_back(std::make_unique<const _business_day_index::indices>(std::move(ind)));
+		current.store(published.back().get(), std::memory_order_release);
+
+		return index;
+	}
+
+}
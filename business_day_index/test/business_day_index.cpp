@@ -0,0 +1,150 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <business_day_index.h>
+
+#include <period.h>
+
+#include <static_data.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <memory>
+#include <stdexcept>
+
+using namespace std;
+using namespace std::chrono;
+using namespace gregorian;
+using namespace gregorian::util;
+using namespace gregorian::static_data;
+
+
+namespace debt_security
+{
+
+	TEST(business_day_index, count_business_days1)
+	{
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto index = business_day_index{ calendar, days_period{ 2008y / January / 1d, 2014y / December / 31d } };
+
+		const auto period = days_period{ 2008y / May / 21d, 2010y / June / 30d };
+		EXPECT_EQ(index.count_business_days(period), 532uz);
+		EXPECT_EQ(index.count_business_days(period), calendar.count_business_days(period));
+	}
+
+	TEST(business_day_index, count_business_days2)
+	{
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto from = 2008y / January / 1d;
+		const auto until = 2009y / December / 31d;
+		const auto index = business_day_index{ calendar, days_period{ from, until } };
+
+		for (auto d = sys_days{ from }; d <= sys_days{ until }; d += days{ 17 })
+		{
+			const auto period = days_period{ from, d };
+			EXPECT_EQ(index.count_business_days(period), calendar.count_business_days(period));
+		}
+	}
+
+	TEST(business_day_index, business_days1)
+	{
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto index = business_day_index{ calendar, days_period{ 2008y / January / 1d, 2014y / December / 31d } };
+
+		const auto start = sys_days{ 2008y / May / 21d };
+		const auto end = sys_days{ 2010y / July / 1d };
+		EXPECT_EQ(index.business_days(start, end), 532);
+		EXPECT_EQ(index.business_days(end, start), -532);
+		EXPECT_EQ(index.business_days(start, start), 0);
+	}
+
+	TEST(business_day_index, business_days2)
+	{
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto index = business_day_index{ calendar, days_period{ 2008y / January / 1d, 2014y / December / 31d } };
+
+		// serial days (since 1970-01-01) give the same as sys_days
+		const auto start = sys_days{ 2008y / May / 21d };
+		const auto end = sys_days{ 2010y / July / 1d };
+		const auto start_serial = static_cast<int32_t>(start.time_since_epoch().count());
+		const auto end_serial = static_cast<int32_t>(end.time_since_epoch().count());
+		EXPECT_EQ(index.business_days(start_serial, end_serial), 532);
+		EXPECT_EQ(index.ordinal(start_serial), index.ordinal(start));
+		EXPECT_THROW(index.ordinal(int32_t{ 0 }), out_of_range);
+	}
+
+	TEST(business_day_index, ordinal1)
+	{
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto from = 2008y / January / 1d;
+		const auto until = 2008y / December / 31d;
+		const auto index = business_day_index{ calendar, days_period{ from, until } };
+
+		EXPECT_EQ(index.ordinal(sys_days{ from }), 0);
+		EXPECT_EQ(index.ordinal(sys_days{ until } + days{ 1 }), static_cast<int32_t>(calendar.count_business_days(days_period{ from, until })));
+		EXPECT_THROW(index.ordinal(sys_days{ from } - days{ 1 }), out_of_range);
+		EXPECT_THROW(index.ordinal(sys_days{ until } + days{ 2 }), out_of_range);
+	}
+
+	TEST(business_day_index, locate_business_day_index1)
+	{
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+
+		const auto index1 = locate_business_day_index(calendar, days_period{ 2008y / May / 21d, 2010y / July / 1d });
+		EXPECT_TRUE(index1->contains(days_period{ 2008y / January / 1d, 2010y / December / 31d }));
+
+		const auto index2 = locate_business_day_index(calendar, days_period{ 2009y / May / 21d, 2010y / July / 1d });
+		EXPECT_EQ(index1, index2); // already covered
+
+		const auto index3 = locate_business_day_index(calendar, days_period{ 2009y / May / 21d, 2012y / July / 1d });
+		EXPECT_NE(index1, index3);
+		EXPECT_TRUE(index3->contains(days_period{ 2008y / January / 1d, 2012y / December / 31d }));
+	}
+
+	TEST(business_day_index, locate_business_day_index2)
+	{
+		const auto calendar = intern_calendar(locate_calendar("America/ANBIMA"s));
+
+		// all threads get an index covering their own period, whether it had to grow or not
+		auto indices = vector<shared_ptr<const business_day_index>>(8uz);
+		{
+			auto threads = vector<jthread>{};
+			for (auto i = 0uz; i < indices.size(); ++i)
+				threads.emplace_back([&, i]()
+				{
+					const auto until = 2001y / December / 31d + years{ static_cast<int>(i) };
+					for (auto j = 0; j < 1000; ++j)
+						indices[i] = locate_business_day_index(*calendar, days_period{ 2001y / January / 1d, until });
+				});
+		}
+
+		for (auto i = 0uz; i < indices.size(); ++i)
+			EXPECT_TRUE(indices[i]->contains(days_period{ 2001y / January / 1d, 2001y / December / 31d + years{ static_cast<int>(i) } }));
+
+		const auto index = locate_business_day_index(*calendar, days_period{ 2001y / January / 1d, 2008y / December / 31d });
+		EXPECT_EQ(index, locate_business_day_index(*calendar, days_period{ 2005y / May / 21d, 2006y / July / 1d }));
+	}
+
+}
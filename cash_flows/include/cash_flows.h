@@ -0,0 +1,182 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <chrono>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <initializer_list>
+
+#include <cash_flow.h>
+
+
+namespace debt_security
+{
+
+	// flows sorted by payment date with at most one flow per date (amounts on the same date are added up)
+	// (contiguous, so pricing loops over it are as cheap as over a vector)
+	template<typename T = double>
+	class cash_flows final
+	{
+
+	public:
+
+		using value_type = fin_calendar::cash_flow<T>;
+		using const_iterator = typename std::vector<value_type>::const_iterator;
+
+	public:
+
+		cash_flows() noexcept = default;
+
+		explicit cash_flows(std::vector<value_type> flows);
+		cash_flows(std::initializer_list<value_type> flows);
+
+	public:
+
+		auto begin() const noexcept -> const_iterator;
+		auto end() const noexcept -> const_iterator;
+
+		auto size() const noexcept -> std::size_t;
+		auto empty() const noexcept -> bool;
+
+		auto operator[](std::size_t i) const noexcept -> const value_type&;
+		auto front() const noexcept -> const value_type&;
+		auto back() const noexcept -> const value_type&;
+
+	public:
+
+		// the flow on the date (or end())
+		auto find(const std::chrono::year_month_day& payment_date) const -> const_iterator;
+
+		// the first flow on or after the date
+		auto lower_bound(const std::chrono::year_month_day& payment_date) const -> const_iterator;
+
+	private:
+
+		std::vector<value_type> flows_{};
+
+	};
+
+
+	template<typename T>
+	cash_flows(std::vector<fin_calendar::cash_flow<T>>) -> cash_flows<T>;
+
+	template<typename T>
+	cash_flows(std::initializer_list<fin_calendar::cash_flow<T>>) -> cash_flows<T>;
+
+
+	template<typename T>
+	cash_flows<T>::cash_flows(std::vector<value_type> flows)
+	{
+		// we sort positions rather than the flows themselves, so cash_flow does not need to be assignable
+		auto order = std::vector<std::size_t>(flows.size());
+		std::iota(order.begin(), order.end(), 0uz);
+		std::ranges::stable_sort(
+			order,
+			{},
+			[&](std::size_t i) -> const std::chrono::year_month_day& { return flows[i].get_payment_date(); }
+		);
+
+		flows_.reserve(flows.size());
+		for (auto i = 0uz; i < order.size();)
+		{
+			const auto& payment_date = flows[order[i]].get_payment_date();
+
+			auto amount = flows[order[i]].get_amount();
+			for (++i; i < order.size() && flows[order[i]].get_payment_date() == payment_date; ++i)
+				amount = T{ amount + flows[order[i]].get_amount() };
+
+			flows_.emplace_back(payment_date, std::move(amount));
+		}
+	}
+
+	template<typename T>
+	cash_flows<T>::cash_flows(std::initializer_list<value_type> flows) :
+		cash_flows{ std::vector<value_type>{ flows } }
+	{
+	}
+
+
+	template<typename T>
+	auto cash_flows<T>::begin() const noexcept -> const_iterator
+	{
+		return flows_.cbegin();
+	}
+
+	template<typename T>
+	auto cash_flows<T>::end() const noexcept -> const_iterator
+	{
+		return flows_.cend();
+	}
+
+	template<typename T>
+	auto cash_flows<T>::size() const noexcept -> std::size_t
+	{
+		return flows_.size();
+	}
+
+	template<typename T>
+	auto cash_flows<T>::empty() const noexcept -> bool
+	{
+		return flows_.empty();
+	}
+
+	template<typename T>
+	auto cash_flows<T>::operator[](std::size_t i) const noexcept -> const value_type&
+	{
+		return flows_[i];
+	}
+
+	template<typename T>
+	auto cash_flows<T>::front() const noexcept -> const value_type&
+	{
+		return flows_.front();
+	}
+
+	template<typename T>
+	auto cash_flows<T>::back() const noexcept -> const value_type&
+	{
+		return flows_.back();
+	}
+
+
+	template<typename T>
+	auto cash_flows<T>::find(const std::chrono::year_month_day& payment_date) const -> const_iterator
+	{
+		const auto it = lower_bound(payment_date);
+		if (it != end() && it->get_payment_date() == payment_date)
+			return it;
+		else
+			return end();
+	}
+
+	template<typename T>
+	auto cash_flows<T>::lower_bound(const std::chrono::year_month_day& payment_date) const -> const_iterator
+	{
+		return std::ranges::lower_bound(flows_, payment_date, {}, &value_type::get_payment_date);
+	}
+
+}
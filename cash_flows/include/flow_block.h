@@ -0,0 +1,125 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <vector>
+#include <span>
+#include <utility>
+
+#include <cash_flow.h>
+
+#include "cash_flows.h"
+
+
+namespace debt_security
+{
+
+	// days since 1970-01-01 (what sys_days counts), which is plenty for int32
+	inline auto to_serial_day(const std::chrono::year_month_day& date) noexcept -> std::int32_t
+	{
+		return static_cast<std::int32_t>(std::chrono::sys_days{ date }.time_since_epoch().count());
+	}
+
+	inline auto from_serial_day(std::int32_t serial_day) noexcept -> std::chrono::year_month_day
+	{
+		return std::chrono::year_month_day{ std::chrono::sys_days{ std::chrono::days{ serial_day } } };
+	}
+
+
+	// flows as a structure of arrays: payment dates as serial days and amounts, each contiguous
+	// (so pricing loops do no date conversions and touch only what they need)
+	template<typename T = double>
+	class flow_block final
+	{
+
+	public:
+
+		flow_block() noexcept = default;
+
+		explicit flow_block(const fin_calendar::cash_flow<T>& flow);
+		explicit flow_block(const cash_flows<T>& flows);
+
+	public:
+
+		auto size() const noexcept -> std::size_t;
+		auto empty() const noexcept -> bool;
+
+		auto get_payment_days() const noexcept -> std::span<const std::int32_t>; // sorted, as cash_flows are
+		auto get_amounts() const noexcept -> std::span<const T>;
+
+	private:
+
+		std::vector<std::int32_t> payment_days_{};
+		std::vector<T> amounts_{};
+
+	};
+
+
+	template<typename T>
+	flow_block<T>::flow_block(const fin_calendar::cash_flow<T>& flow) :
+		payment_days_{ to_serial_day(flow.get_payment_date()) },
+		amounts_{ flow.get_amount() }
+	{
+	}
+
+	template<typename T>
+	flow_block<T>::flow_block(const cash_flows<T>& flows)
+	{
+		payment_days_.reserve(flows.size());
+		amounts_.reserve(flows.size());
+		for (const auto& flow : flows)
+		{
+			payment_days_.push_back(to_serial_day(flow.get_payment_date()));
+			amounts_.push_back(flow.get_amount());
+		}
+	}
+
+
+	template<typename T>
+	auto flow_block<T>::size() const noexcept -> std::size_t
+	{
+		return payment_days_.size();
+	}
+
+	template<typename T>
+	auto flow_block<T>::empty() const noexcept -> bool
+	{
+		return payment_days_.empty();
+	}
+
+	template<typename T>
+	auto flow_block<T>::get_payment_days() const noexcept -> std::span<const std::int32_t>
+	{
+		return payment_days_;
+	}
+
+	template<typename T>
+	auto flow_block<T>::get_amounts() const noexcept -> std::span<const T>
+	{
+		return amounts_;
+	}
+
+}
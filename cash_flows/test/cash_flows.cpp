@@ -0,0 +1,84 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cash_flows.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+using namespace fin_calendar;
+
+
+namespace debt_security
+{
+
+	TEST(cash_flows, constructor1)
+	{
+		const auto cfs = cash_flows<double>{};
+
+		EXPECT_TRUE(cfs.empty());
+		EXPECT_EQ(cfs.size(), 0uz);
+	}
+
+	TEST(cash_flows, constructor2)
+	{
+		// a final coupon and the principal on the same date, out of order
+		const auto cfs = cash_flows{
+			cash_flow{ 2014y / January / 2d, 48.80885 },
+			cash_flow{ 2013y / July / 1d, 48.80885 },
+			cash_flow{ 2014y / January / 2d, 1'000.0 }
+		};
+
+		ASSERT_EQ(cfs.size(), 2uz);
+		EXPECT_EQ(cfs.front().get_payment_date(), 2013y / July / 1d);
+		EXPECT_EQ(cfs.front().get_amount(), 48.80885);
+		EXPECT_EQ(cfs.back().get_payment_date(), 2014y / January / 2d);
+		EXPECT_EQ(cfs.back().get_amount(), 1'048.80885);
+		EXPECT_EQ(&cfs[1], &cfs.back());
+	}
+
+	TEST(cash_flows, find1)
+	{
+		const auto cfs = cash_flows{ vector{
+			cash_flow{ 2008y / July / 1d, 1.0 },
+			cash_flow{ 2009y / January / 2d, 2.0 },
+			cash_flow{ 2009y / July / 1d, 3.0 }
+		} };
+
+		EXPECT_EQ(cfs.find(2009y / January / 2d)->get_amount(), 2.0);
+		EXPECT_EQ(cfs.find(2009y / January / 1d), cfs.end());
+
+		EXPECT_EQ(cfs.lower_bound(2008y / May / 21d), cfs.begin());
+		EXPECT_EQ(cfs.lower_bound(2009y / January / 1d)->get_amount(), 2.0);
+		EXPECT_EQ(cfs.lower_bound(2009y / July / 2d), cfs.end());
+
+		auto total = 0.0;
+		for (const auto& cf : cfs)
+			total += cf.get_amount();
+		EXPECT_EQ(total, 6.0);
+	}
+
+}
@@ -0,0 +1,73 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <flow_block.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using namespace std;
+using namespace std::chrono;
+using namespace fin_calendar;
+
+
+namespace debt_security
+{
+
+	TEST(flow_block, serial_day1)
+	{
+		EXPECT_EQ(to_serial_day(1970y / January / 1d), 0);
+		EXPECT_EQ(to_serial_day(1969y / December / 31d), -1);
+		EXPECT_EQ(to_serial_day(2008y / May / 21d), 14'020);
+		EXPECT_EQ(from_serial_day(14'020), 2008y / May / 21d);
+	}
+
+	TEST(flow_block, constructor1)
+	{
+		const auto block = flow_block{ cash_flow{ 2010y / July / 1d, 1'000.0 } };
+
+		ASSERT_EQ(block.size(), 1uz);
+		EXPECT_EQ(block.get_payment_days()[0], to_serial_day(2010y / July / 1d));
+		EXPECT_EQ(block.get_amounts()[0], 1'000.0);
+	}
+
+	TEST(flow_block, constructor2)
+	{
+		const auto cfs = cash_flows{
+			cash_flow{ 2014y / January / 2d, 48.80885 },
+			cash_flow{ 2013y / July / 1d, 48.80885 },
+			cash_flow{ 2014y / January / 2d, 1'000.0 }
+		};
+		const auto block = flow_block{ cfs };
+
+		ASSERT_EQ(block.size(), cfs.size());
+		for (auto i = 0uz; i < block.size(); ++i)
+		{
+			EXPECT_EQ(from_serial_day(block.get_payment_days()[i]), cfs[i].get_payment_date());
+			EXPECT_EQ(block.get_amounts()[i], cfs[i].get_amount());
+		}
+
+		EXPECT_TRUE(flow_block<double>{}.empty());
+	}
+
+}
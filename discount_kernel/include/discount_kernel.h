@@ -0,0 +1,324 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define DEBT_SECURITY_DISCOUNT_KERNEL_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// gcc and clang only generate avx code for functions which ask for it (msvc does not need to be asked)
+#if defined(__GNUC__) || defined(__clang__)
+#define DEBT_SECURITY_TARGET(isa) __attribute__((target(isa)))
+#else
+#define DEBT_SECURITY_TARGET(isa)
+#endif
+
+
+namespace debt_security
+{
+
+	// instruction sets discount_factors could run on
+	enum class vector_isa
+	{
+		portable,
+		avx2, // together with fma
+		avx512 // avx512f
+	};
+
+
+	// relative error of each discount factor against the exact exp of the rounded -year_fraction * log_base
+	// (the kernel is good to a few ulps, this leaves some room)
+	inline constexpr auto discount_factor_error = 1e-15;
+
+
+	// the best instruction set of this cpu (detected once)
+	inline auto best_vector_isa() noexcept -> vector_isa;
+
+	inline auto is_supported(vector_isa isa) noexcept -> bool;
+
+
+	// factors[i] = exp(-year_fractions[i] * log_bases[i]), so (1 + y)^-t for log_base = log(1 + y)
+	// (as long as |t * log_base| < 708, so that neither a factor nor its reciprocal overflows)
+	inline auto discount_factors(
+		std::span<const double> log_bases,
+		std::span<const double> year_fractions,
+		std::span<double> factors
+	) -> void;
+
+	inline auto discount_factors(
+		vector_isa isa,
+		std::span<const double> log_bases,
+		std::span<const double> year_fractions,
+		std::span<double> factors
+	) -> void;
+
+
+	// exp as a range reduction to r = x - k * log(2) with |r| <= log(2) / 2 and a polynomial for exp(r),
+	// the same steps for each instruction set (only avx uses fma)
+	namespace _discount_kernel
+	{
+
+		inline constexpr auto log2e = 1.4426950408889634;
+		inline constexpr auto ln2_hi = 6.93147180369123816490e-01; // the bottom 32 bits are 0, so k * ln2_hi is exact
+		inline constexpr auto ln2_lo = 1.90821492927058770002e-10;
+		inline constexpr auto max_x = 708.0;
+
+		// 1 / n! for the Taylor series up to r^13 (the first term left out is below 1e-17 for |r| <= log(2) / 2)
+		inline constexpr auto inverse_factorials = []
+		{
+			auto result = std::array<double, 14>{};
+			auto factorial = 1.0;
+			for (auto n = 0uz; n < result.size(); ++n)
+			{
+				if (n > 0uz)
+					factorial *= static_cast<double>(n);
+				result[n] = 1.0 / factorial;
+			}
+			return result;
+		}();
+
+
+		inline auto exp_portable(double x) noexcept -> double
+		{
+			x = std::fmin(std::fmax(x, -max_x), max_x);
+
+			const auto k = std::nearbyint(x * log2e);
+			const auto r = (x - k * ln2_hi) - k * ln2_lo;
+
+			auto p = inverse_factorials.back();
+			for (auto n = inverse_factorials.size() - 1uz; n-- > 0uz;)
+				p = p * r + inverse_factorials[n];
+
+			return std::ldexp(p, static_cast<int>(k));
+		}
+
+		inline auto discount_factors_portable(
+			const double* log_bases,
+			const double* year_fractions,
+			double* factors,
+			std::size_t n
+		) noexcept -> void
+		{
+			for (auto i = 0uz; i < n; ++i)
+				factors[i] = exp_portable(-(year_fractions[i] * log_bases[i]));
+		}
+
+
+#if defined(DEBT_SECURITY_DISCOUNT_KERNEL_X86)
+
+		DEBT_SECURITY_TARGET("avx2,fma")
+		inline auto exp_avx2(__m256d x) noexcept -> __m256d
+		{
+			x = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(-max_x)), _mm256_set1_pd(max_x));
+
+			const auto k = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(log2e)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+			auto r = _mm256_fnmadd_pd(k, _mm256_set1_pd(ln2_hi), x);
+			r = _mm256_fnmadd_pd(k, _mm256_set1_pd(ln2_lo), r);
+
+			auto p = _mm256_set1_pd(inverse_factorials.back());
+			for (auto n = inverse_factorials.size() - 1uz; n-- > 0uz;)
+				p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(inverse_factorials[n]));
+
+			// 2^k from its bits: k + 2^52 + 2^51 has k in the bottom bits of the mantissa (avx2 can not convert to int64)
+			const auto magic = _mm256_set1_pd(6'755'399'441'055'744.0);
+			const auto k_bits = _mm256_castpd_si256(_mm256_add_pd(k, magic));
+			const auto scale = _mm256_slli_epi64(_mm256_add_epi64(k_bits, _mm256_set1_epi64x(1023)), 52);
+
+			return _mm256_mul_pd(p, _mm256_castsi256_pd(scale));
+		}
+
+		DEBT_SECURITY_TARGET("avx2,fma")
+		inline auto discount_factors_avx2(
+			const double* log_bases,
+			const double* year_fractions,
+			double* factors,
+			std::size_t n
+		) noexcept -> void
+		{
+			const auto zero = _mm256_setzero_pd();
+
+			auto i = 0uz;
+			for (; i + 4uz <= n; i += 4uz)
+			{
+				const auto x = _mm256_sub_pd(zero, _mm256_mul_pd(_mm256_loadu_pd(year_fractions + i), _mm256_loadu_pd(log_bases + i)));
+				_mm256_storeu_pd(factors + i, exp_avx2(x));
+			}
+
+			if (i < n) // the tail goes through the same steps as the rest
+			{
+				const auto rest = static_cast<long long>(n - i);
+				const auto mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(rest), _mm256_set_epi64x(3, 2, 1, 0));
+				const auto x = _mm256_sub_pd(zero, _mm256_mul_pd(_mm256_maskload_pd(year_fractions + i, mask), _mm256_maskload_pd(log_bases + i, mask)));
+				_mm256_maskstore_pd(factors + i, mask, exp_avx2(x));
+			}
+		}
+
+
+		DEBT_SECURITY_TARGET("avx512f")
+		inline auto exp_avx512(__m512d x) noexcept -> __m512d
+		{
+			x = _mm512_min_pd(_mm512_max_pd(x, _mm512_set1_pd(-max_x)), _mm512_set1_pd(max_x));
+
+			const auto k = _mm512_roundscale_pd(_mm512_mul_pd(x, _mm512_set1_pd(log2e)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+			auto r = _mm512_fnmadd_pd(k, _mm512_set1_pd(ln2_hi), x);
+			r = _mm512_fnmadd_pd(k, _mm512_set1_pd(ln2_lo), r);
+
+			auto p = _mm512_set1_pd(inverse_factorials.back());
+			for (auto n = inverse_factorials.size() - 1uz; n-- > 0uz;)
+				p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(inverse_factorials[n]));
+
+			return _mm512_scalef_pd(p, k); // p * 2^k
+		}
+
+		DEBT_SECURITY_TARGET("avx512f")
+		inline auto discount_factors_avx512(
+			const double* log_bases,
+			const double* year_fractions,
+			double* factors,
+			std::size_t n
+		) noexcept -> void
+		{
+			const auto zero = _mm512_setzero_pd();
+
+			auto i = 0uz;
+			for (; i + 8uz <= n; i += 8uz)
+			{
+				const auto x = _mm512_sub_pd(zero, _mm512_mul_pd(_mm512_loadu_pd(year_fractions + i), _mm512_loadu_pd(log_bases + i)));
+				_mm512_storeu_pd(factors + i, exp_avx512(x));
+			}
+
+			if (i < n)
+			{
+				const auto mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+				const auto x = _mm512_sub_pd(zero, _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, year_fractions + i), _mm512_maskz_loadu_pd(mask, log_bases + i)));
+				_mm512_mask_storeu_pd(factors + i, mask, exp_avx512(x));
+			}
+		}
+
+#endif
+
+
+		inline auto detect_isa() noexcept -> vector_isa
+		{
+#if defined(DEBT_SECURITY_DISCOUNT_KERNEL_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+			// cpu support is not enough, the os also has to save the wider registers
+			auto info = std::array<int, 4>{};
+			__cpuid(info.data(), 1);
+			const auto fma = (info[2] & (1 << 12)) != 0;
+			const auto osxsave = (info[2] & (1 << 27)) != 0;
+			if (!osxsave)
+				return vector_isa::portable;
+
+			const auto xcr0 = _xgetbv(0);
+			__cpuidex(info.data(), 7, 0);
+			const auto avx2 = (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+			const auto avx512f = (info[1] & (1 << 16)) != 0 && (xcr0 & 0xe6) == 0xe6;
+#else
+			__builtin_cpu_init();
+			const auto fma = __builtin_cpu_supports("fma") != 0;
+			const auto avx2 = __builtin_cpu_supports("avx2") != 0;
+			const auto avx512f = __builtin_cpu_supports("avx512f") != 0;
+#endif
+			if (avx512f)
+				return vector_isa::avx512;
+			if (avx2 && fma)
+				return vector_isa::avx2;
+#endif
+			return vector_isa::portable;
+		}
+
+	}
+
+
+	inline auto best_vector_isa() noexcept -> vector_isa
+	{
+		static const auto isa = _discount_kernel::detect_isa();
+		return isa;
+	}
+
+
+	inline auto is_supported(vector_isa isa) noexcept -> bool
+	{
+		switch (best_vector_isa())
+		{
+		case vector_isa::avx512: return true; // avx512f implies avx2 and fma
+		case vector_isa::avx2: return isa != vector_isa::avx512;
+		default: return isa == vector_isa::portable;
+		}
+	}
+
+
+	inline auto discount_factors(
+		std::span<const double> log_bases,
+		std::span<const double> year_fractions,
+		std::span<double> factors
+	) -> void
+	{
+		discount_factors(best_vector_isa(), log_bases, year_fractions, factors);
+	}
+
+
+	inline auto discount_factors(
+		vector_isa isa,
+		std::span<const double> log_bases,
+		std::span<const double> year_fractions,
+		std::span<double> factors
+	) -> void
+	{
+		if (log_bases.size() != year_fractions.size() || factors.size() != year_fractions.size())
+			throw std::invalid_argument{ "Log bases, year fractions and factors must have the same size" };
+
+		if (!is_supported(isa))
+			throw std::invalid_argument{ "Instruction set is not supported by this cpu" };
+
+		const auto n = factors.size();
+
+		switch (isa)
+		{
+#if defined(DEBT_SECURITY_DISCOUNT_KERNEL_X86)
+		case vector_isa::avx512:
+			_discount_kernel::discount_factors_avx512(log_bases.data(), year_fractions.data(), factors.data(), n);
+			break;
+		case vector_isa::avx2:
+			_discount_kernel::discount_factors_avx2(log_bases.data(), year_fractions.data(), factors.data(), n);
+			break;
+#endif
+		default:
+			_discount_kernel::discount_factors_portable(log_bases.data(), year_fractions.data(), factors.data(), n);
+			break;
+		}
+	}
+
+}
@@ -0,0 +1,107 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <discount_kernel.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+#include <stdexcept>
+
+using namespace std;
+
+
+namespace debt_security
+{
+
+	static auto _isas() -> vector<vector_isa>
+	{
+		auto result = vector<vector_isa>{};
+		for (const auto isa : { vector_isa::portable, vector_isa::avx2, vector_isa::avx512 })
+			if (is_supported(isa))
+				result.push_back(isa);
+		return result;
+	}
+
+
+	TEST(discount_kernel, is_supported1)
+	{
+		EXPECT_TRUE(is_supported(vector_isa::portable));
+		EXPECT_TRUE(is_supported(best_vector_isa()));
+	}
+
+	TEST(discount_kernel, discount_factors1)
+	{
+		// yields from -50% to 100% and up to 60 years of 252 business days
+		auto log_bases = vector<double>{};
+		auto year_fractions = vector<double>{};
+		for (auto yield = -0.5; yield <= 1.0; yield += 0.0137)
+			for (auto business_days = 0; business_days <= 252 * 60; business_days += 97)
+			{
+				log_bases.push_back(log(1.0 + yield));
+				year_fractions.push_back(business_days / 252.0);
+			}
+
+		for (const auto isa : _isas())
+		{
+			auto factors = vector<double>(log_bases.size());
+			discount_factors(isa, log_bases, year_fractions, factors);
+
+			for (auto i = 0uz; i < factors.size(); ++i)
+			{
+				const auto expected = exp(-(year_fractions[i] * log_bases[i]));
+				EXPECT_LE(abs(factors[i] - expected), expected * discount_factor_error) << static_cast<int>(isa) << " " << i;
+			}
+		}
+	}
+
+	TEST(discount_kernel, discount_factors2)
+	{
+		// every length up to a few vectors, so that each of the tails is exercised
+		for (const auto isa : _isas())
+			for (auto n = 0uz; n <= 19uz; ++n)
+			{
+				const auto log_bases = vector<double>(n, log(1.1436));
+				auto year_fractions = vector<double>(n);
+				for (auto i = 0uz; i < n; ++i)
+					year_fractions[i] = static_cast<double>(i) / 4.0;
+
+				auto factors = vector<double>(n + 1uz, -1.0); // one past the end must not be written
+				discount_factors(isa, log_bases, year_fractions, span{ factors }.first(n));
+
+				for (auto i = 0uz; i < n; ++i)
+					EXPECT_NEAR(factors[i], pow(1.1436, -year_fractions[i]), 1e-15);
+				EXPECT_EQ(factors[n], -1.0);
+			}
+	}
+
+	TEST(discount_kernel, discount_factors3)
+	{
+		const auto log_bases = vector<double>(3uz, 0.1);
+		const auto year_fractions = vector<double>(2uz, 1.0);
+		auto factors = vector<double>(2uz);
+
+		EXPECT_THROW(discount_factors(log_bases, year_fractions, factors), invalid_argument);
+	}
+
+}
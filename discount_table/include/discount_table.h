@@ -0,0 +1,218 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <stdexcept>
+
+#include <resets_math.h>
+
+
+namespace debt_security
+{
+
+	// business days / 252, truncated to 14 decimal places (as in ANBIMA methodology)
+	template<typename T = double>
+	auto year_fraction_252(std::int32_t business_days) -> T
+	{
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			return reset::trunc_dp(static_cast<T>(business_days) / T{ 252 }, 14u); // ok to hard code this?
+		}
+		else
+		{
+			// decimal division is not exact (504 / 252 comes out just below 2 and then truncates to 1.99999999999999),
+			// so we truncate in integers and only scale the result
+			const auto whole_years = business_days / 252;
+			const auto digits = std::int64_t{ business_days % 252 } * 100'000'000'000'000 / 252; // 14 decimal places
+
+			return T{ static_cast<T>(whole_years) + static_cast<T>(digits) * T{ "1e-14" } };
+		}
+	}
+
+
+	// (1 + yield)^year_fraction_252(n) for all n up to some number of business days
+	// as q + trunc(r / 252) = trunc((252 * q + r) / 252) we only need a pow for each of the 252 days of a year
+	// and for each whole year - the rest are products of the two
+	// (this identity does not survive binary truncation, so for float and double we take a pow for each n,
+	// which gives exactly what the pricer would have calculated)
+	template<typename T = double>
+	class discount_table final
+	{
+
+	public:
+
+		explicit discount_table(
+			T yield,
+			std::int32_t max_business_days
+		);
+
+	public:
+
+		auto get_yield() const noexcept -> const T&;
+		auto get_max_business_days() const noexcept -> std::int32_t;
+
+	public:
+
+		auto compounding_factor(std::int32_t business_days) const -> const T&;
+
+	private:
+
+		T yield_{};
+		std::vector<T> factors_{};
+
+	};
+
+
+	template<typename T>
+	discount_table<T>::discount_table(
+		T yield,
+		std::int32_t max_business_days
+	) :
+		yield_{ std::move(yield) }
+	{
+		using std::pow;
+
+		if (max_business_days < 0)
+			throw std::out_of_range{ "Number of business days can not be negative" };
+
+		constexpr auto days_in_year = std::int32_t{ 252 };
+
+		const auto base = T{ T{ 1 } + yield_ };
+
+		factors_.reserve(static_cast<std::size_t>(max_business_days) + 1uz);
+
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			for (auto n = std::int32_t{ 0 }; n <= max_business_days; ++n)
+				factors_.push_back(pow(base, year_fraction_252<T>(n)));
+		}
+		else
+		{
+			auto within_year = std::vector<T>{};
+			within_year.reserve(std::min(max_business_days + 1, days_in_year));
+			for (auto r = std::int32_t{ 0 }; r < days_in_year && r <= max_business_days; ++r)
+				within_year.push_back(pow(base, year_fraction_252<T>(r)));
+
+			for (auto q = std::int32_t{ 0 }; q * days_in_year <= max_business_days; ++q)
+			{
+				const auto whole_years = T{ pow(base, q) }; // rather than a running product, so errors do not accumulate
+				for (auto r = std::int32_t{ 0 }; r < days_in_year && q * days_in_year + r <= max_business_days; ++r)
+					factors_.push_back(T{ whole_years * within_year[r] });
+			}
+		}
+	}
+
+
+	template<typename T>
+	auto discount_table<T>::get_yield() const noexcept -> const T&
+	{
+		return yield_;
+	}
+
+	template<typename T>
+	auto discount_table<T>::get_max_business_days() const noexcept -> std::int32_t
+	{
+		return static_cast<std::int32_t>(factors_.size()) - 1;
+	}
+
+
+	template<typename T>
+	auto discount_table<T>::compounding_factor(std::int32_t business_days) const -> const T&
+	{
+		if (business_days < 0 || static_cast<std::size_t>(business_days) >= factors_.size())
+			throw std::out_of_range{ "Number of business days is outside of the discount table" };
+
+		return factors_[static_cast<std::size_t>(business_days)];
+	}
+
+
+	// tables keyed by yield, so callers pricing many instruments at the same yields do not rebuild them
+	// (we just start again when the capacity is reached - yields tend to come in batches)
+	template<typename T = double>
+	class discount_tables final
+	{
+
+	public:
+
+		explicit discount_tables(std::size_t capacity = 64uz) noexcept;
+
+	public:
+
+		auto locate(
+			const T& yield,
+			std::int32_t max_business_days
+		) -> std::shared_ptr<const discount_table<T>>;
+
+	private:
+
+		std::size_t capacity_{};
+
+		std::mutex mutex_{};
+		std::map<T, std::shared_ptr<const discount_table<T>>> tables_{};
+
+	};
+
+
+	template<typename T>
+	discount_tables<T>::discount_tables(std::size_t capacity) noexcept :
+		capacity_{ capacity }
+	{
+	}
+
+
+	template<typename T>
+	auto discount_tables<T>::locate(
+		const T& yield,
+		std::int32_t max_business_days
+	) -> std::shared_ptr<const discount_table<T>>
+	{
+		const auto lock = std::lock_guard{ mutex_ };
+
+		const auto it = tables_.find(yield);
+		if (it != tables_.end() && it->second->get_max_business_days() >= max_business_days)
+			return it->second;
+
+		if (it == tables_.end() && tables_.size() >= capacity_)
+			tables_.clear();
+
+		const auto size = it != tables_.end() ? // grow geometrically, so a slowly increasing maturity does not rebuild every time
+			std::max(max_business_days, 2 * it->second->get_max_business_days()) :
+			max_business_days;
+
+		auto table = std::make_shared<const discount_table<T>>(yield, size);
+		tables_.insert_or_assign(yield, table);
+
+		return table;
+	}
+
+}
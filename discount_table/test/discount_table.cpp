@@ -0,0 +1,104 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <boost/multiprecision/cpp_dec_float.hpp>
+
+#include <discount_table.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+using namespace boost::multiprecision;
+
+
+namespace debt_security
+{
+
+	TEST(discount_table, year_fraction_2521)
+	{
+		EXPECT_EQ(year_fraction_252<cpp_dec_float_50>(532), cpp_dec_float_50{ "2.11111111111111" });
+		EXPECT_EQ(year_fraction_252<cpp_dec_float_50>(252), cpp_dec_float_50{ 1 });
+		EXPECT_EQ(year_fraction_252<cpp_dec_float_50>(504), cpp_dec_float_50{ 2 });
+		EXPECT_EQ(year_fraction_252<cpp_dec_float_50>(-532), cpp_dec_float_50{ "-2.11111111111111" });
+		EXPECT_EQ(year_fraction_252<cpp_dec_float_50>(0), cpp_dec_float_50{ 0 });
+	}
+
+	TEST(discount_table, year_fraction_2522)
+	{
+		EXPECT_NEAR(year_fraction_252(532), 2.11111111111111, 1e-15);
+		EXPECT_EQ(year_fraction_252(504), 2.0);
+	}
+
+	TEST(discount_table, compounding_factor1)
+	{
+		const auto yield = 0.1436;
+		const auto table = discount_table{ yield, 252 * 50 };
+
+		EXPECT_EQ(table.get_yield(), yield);
+		EXPECT_EQ(table.get_max_business_days(), 252 * 50);
+
+		for (auto n = 0; n <= table.get_max_business_days(); ++n)
+			EXPECT_EQ(table.compounding_factor(n), pow(1.0 + yield, year_fraction_252(n)));
+	}
+
+	TEST(discount_table, compounding_factor2)
+	{
+		const auto yield = cpp_dec_float_50{ "0.1366" };
+		const auto table = discount_table{ yield, 1'500 };
+
+		for (auto n = 0; n <= table.get_max_business_days(); n += 7)
+		{
+			const auto expected = cpp_dec_float_50{ pow(1 + yield, year_fraction_252<cpp_dec_float_50>(n)) };
+			EXPECT_LT(abs(table.compounding_factor(n) - expected), expected * cpp_dec_float_50{ "1e-45" });
+		}
+	}
+
+	TEST(discount_table, compounding_factor3)
+	{
+		const auto table = discount_table{ 0.1, 100 };
+
+		EXPECT_EQ(table.compounding_factor(0), 1.0);
+		EXPECT_THROW(table.compounding_factor(-1), out_of_range);
+		EXPECT_THROW(table.compounding_factor(101), out_of_range);
+	}
+
+	TEST(discount_tables, locate1)
+	{
+		auto tables = discount_tables<double>{};
+
+		const auto t1 = tables.locate(0.1, 500);
+		const auto t2 = tables.locate(0.1, 400);
+		EXPECT_EQ(t1, t2); // already covered
+
+		const auto t3 = tables.locate(0.1, 600);
+		EXPECT_NE(t1, t3);
+		EXPECT_GE(t3->get_max_business_days(), 1'000); // grows geometrically
+
+		const auto t4 = tables.locate(0.2, 600);
+		EXPECT_NE(t3, t4);
+		EXPECT_EQ(t4->get_yield(), 0.2);
+	}
+
+}
@@ -0,0 +1,1055 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <type_traits>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <ostream>
+#include <utility>
+#include <stdexcept>
+#include <system_error>
+
+
+namespace debt_security
+{
+
+	// unsigned integers as little endian 32 bit limbs, just enough for the fixed_decimal below
+	// (portable - we do not want to depend on __int128)
+	namespace _fixed_decimal
+	{
+
+		template<std::size_t N>
+		using limbs = std::array<std::uint32_t, N>;
+
+
+		template<std::size_t N>
+		constexpr auto is_zero(const limbs<N>& a) noexcept -> bool
+		{
+			for (const auto l : a)
+				if (l != 0u)
+					return false;
+
+			return true;
+		}
+
+		template<std::size_t N>
+		constexpr auto compare(const limbs<N>& a, const limbs<N>& b) noexcept -> std::strong_ordering
+		{
+			for (auto i = N; i-- > 0uz;)
+				if (a[i] != b[i])
+					return a[i] <=> b[i];
+
+			return std::strong_ordering::equal;
+		}
+
+		template<std::size_t N>
+		constexpr auto bit_length(const limbs<N>& a) noexcept -> std::size_t
+		{
+			for (auto i = N; i-- > 0uz;)
+				if (a[i] != 0u)
+					return i * 32uz + static_cast<std::size_t>(std::bit_width(a[i]));
+
+			return 0uz;
+		}
+
+		// true if the value fits into M limbs
+		template<std::size_t M, std::size_t N>
+		constexpr auto fits(const limbs<N>& a) noexcept -> bool
+		{
+			for (auto i = M; i < N; ++i)
+				if (a[i] != 0u)
+					return false;
+
+			return true;
+		}
+
+		// the value has to fit (or M >= N)
+		template<std::size_t M, std::size_t N>
+		constexpr auto resize(const limbs<N>& a) noexcept -> limbs<M>
+		{
+			auto result = limbs<M>{};
+			for (auto i = 0uz; i < M && i < N; ++i)
+				result[i] = a[i];
+
+			return result;
+		}
+
+
+		template<std::size_t N>
+		constexpr auto add(limbs<N>& a, const limbs<N>& b) noexcept -> std::uint32_t // returns the carry
+		{
+			auto carry = std::uint64_t{ 0 };
+			for (auto i = 0uz; i < N; ++i)
+			{
+				carry += std::uint64_t{ a[i] } + b[i];
+				a[i] = static_cast<std::uint32_t>(carry);
+				carry >>= 32;
+			}
+
+			return static_cast<std::uint32_t>(carry);
+		}
+
+		template<std::size_t N>
+		constexpr auto sub(limbs<N>& a, const limbs<N>& b) noexcept -> std::uint32_t // returns the borrow
+		{
+			auto borrow = std::uint64_t{ 0 };
+			for (auto i = 0uz; i < N; ++i)
+			{
+				const auto d = std::uint64_t{ a[i] } - b[i] - borrow;
+				a[i] = static_cast<std::uint32_t>(d);
+				borrow = (d >> 63) & 1u;
+			}
+
+			return static_cast<std::uint32_t>(borrow);
+		}
+
+		template<std::size_t N>
+		constexpr auto negate(limbs<N>& a) noexcept -> void // two's complement
+		{
+			auto carry = std::uint64_t{ 1 };
+			for (auto& l : a)
+			{
+				carry += static_cast<std::uint32_t>(~l);
+				l = static_cast<std::uint32_t>(carry);
+				carry >>= 32;
+			}
+		}
+
+		template<std::size_t N, std::size_t M>
+		constexpr auto mul(const limbs<N>& a, const limbs<M>& b) noexcept -> limbs<N + M>
+		{
+			auto result = limbs<N + M>{};
+			for (auto i = 0uz; i < N; ++i)
+			{
+				if (a[i] == 0u)
+					continue;
+
+				auto carry = std::uint64_t{ 0 };
+				for (auto j = 0uz; j < M; ++j)
+				{
+					carry += std::uint64_t{ a[i] } * b[j] + result[i + j];
+					result[i + j] = static_cast<std::uint32_t>(carry);
+					carry >>= 32;
+				}
+				result[i + M] = static_cast<std::uint32_t>(carry);
+			}
+
+			return result;
+		}
+
+		template<std::size_t N>
+		constexpr auto shift_left(const limbs<N>& a, std::size_t bits) noexcept -> limbs<N> // bits shifted out are lost
+		{
+			auto result = limbs<N>{};
+			const auto whole = bits / 32uz;
+			const auto part = bits % 32uz;
+			for (auto i = N; i-- > whole;)
+			{
+				auto l = std::uint64_t{ a[i - whole] } << part;
+				if (part != 0uz && i - whole > 0uz)
+					l |= std::uint64_t{ a[i - whole - 1uz] } >> (32uz - part);
+				result[i] = static_cast<std::uint32_t>(l);
+			}
+
+			return result;
+		}
+
+		// Knuth's algorithm D (as in Hacker's Delight), v must not be zero
+		template<std::size_t N, std::size_t M>
+		constexpr auto divmod(const limbs<N>& u, const limbs<M>& v) -> std::pair<limbs<N>, limbs<M>>
+		{
+			auto q = limbs<N>{};
+			auto r = limbs<M>{};
+
+			auto m = N;
+			while (m > 0uz && u[m - 1uz] == 0u)
+				--m;
+			auto n = M;
+			while (n > 0uz && v[n - 1uz] == 0u)
+				--n;
+
+			if (n == 0uz)
+				throw std::domain_error{ "Division by zero" };
+
+			if (m < n)
+			{
+				for (auto i = 0uz; i < M && i < N; ++i)
+					r[i] = u[i];
+				return { q, r };
+			}
+
+			constexpr auto b = std::uint64_t{ 1 } << 32;
+
+			if (n == 1uz)
+			{
+				auto k = std::uint64_t{ 0 };
+				for (auto j = m; j-- > 0uz;)
+				{
+					const auto num = k * b + u[j];
+					q[j] = static_cast<std::uint32_t>(num / v[0]);
+					k = num % v[0];
+				}
+				r[0] = static_cast<std::uint32_t>(k);
+				return { q, r };
+			}
+
+			// normalise, so the top bit of the divisor is set
+			const auto s = std::countl_zero(v[n - 1uz]);
+
+			auto vn = limbs<M>{};
+			for (auto i = n - 1uz; i > 0uz; --i)
+				vn[i] = static_cast<std::uint32_t>((std::uint64_t{ v[i] } << s) | (std::uint64_t{ v[i - 1uz] } >> (32 - s)));
+			vn[0] = static_cast<std::uint32_t>(std::uint64_t{ v[0] } << s);
+
+			auto un = std::array<std::uint32_t, N + 1uz>{};
+			un[m] = static_cast<std::uint32_t>(std::uint64_t{ u[m - 1uz] } >> (32 - s));
+			for (auto i = m - 1uz; i > 0uz; --i)
+				un[i] = static_cast<std::uint32_t>((std::uint64_t{ u[i] } << s) | (std::uint64_t{ u[i - 1uz] } >> (32 - s)));
+			un[0] = static_cast<std::uint32_t>(std::uint64_t{ u[0] } << s);
+
+			for (auto j = m - n + 1uz; j-- > 0uz;)
+			{
+				const auto num = std::uint64_t{ un[j + n] } * b + un[j + n - 1uz];
+				auto qhat = num / vn[n - 1uz];
+				auto rhat = num - qhat * vn[n - 1uz];
+
+				while (qhat >= b || qhat * vn[n - 2uz] > b * rhat + un[j + n - 2uz])
+				{
+					--qhat;
+					rhat += vn[n - 1uz];
+					if (rhat >= b)
+						break;
+				}
+
+				// multiply and subtract
+				auto k = std::int64_t{ 0 };
+				auto t = std::int64_t{ 0 };
+				for (auto i = 0uz; i < n; ++i)
+				{
+					const auto p = qhat * vn[i];
+					t = std::int64_t{ un[i + j] } - k - static_cast<std::int64_t>(p & 0xFFFFFFFFu);
+					un[i + j] = static_cast<std::uint32_t>(t);
+					k = static_cast<std::int64_t>(p >> 32) - (t >> 32);
+				}
+				t = std::int64_t{ un[j + n] } - k;
+				un[j + n] = static_cast<std::uint32_t>(t);
+
+				q[j] = static_cast<std::uint32_t>(qhat);
+				if (t < 0) // subtracted too much, add back
+				{
+					--q[j];
+					auto c = std::uint64_t{ 0 };
+					for (auto i = 0uz; i < n; ++i)
+					{
+						c += std::uint64_t{ un[i + j] } + vn[i];
+						un[i + j] = static_cast<std::uint32_t>(c);
+						c >>= 32;
+					}
+					un[j + n] = static_cast<std::uint32_t>(un[j + n] + c);
+				}
+			}
+
+			// unnormalise the remainder
+			for (auto i = 0uz; i < n; ++i)
+				r[i] = static_cast<std::uint32_t>((std::uint64_t{ un[i] } >> s) | (std::uint64_t{ un[i + 1uz] } << (32 - s)));
+
+			return { q, r };
+		}
+
+		template<std::size_t N>
+		constexpr auto pow10(unsigned int n) -> limbs<N>
+		{
+			auto result = limbs<N>{};
+			result[0] = 1u;
+			for (auto i = 0u; i < n; ++i)
+			{
+				auto carry = std::uint64_t{ 0 };
+				for (auto& l : result)
+				{
+					carry += std::uint64_t{ l } * 10u;
+					l = static_cast<std::uint32_t>(carry);
+					carry >>= 32;
+				}
+				if (carry != 0u)
+					throw std::overflow_error{ "Power of 10 does not fit" };
+			}
+
+			return result;
+		}
+
+		// u / v rounded half to even
+		template<std::size_t N, std::size_t M>
+		constexpr auto divide_round(const limbs<N>& u, const limbs<M>& v) -> limbs<N>
+		{
+			auto [q, r] = divmod(u, v);
+
+			// compare 2 * r with v (in one more limb, so doubling can not overflow)
+			auto r2 = shift_left(resize<M + 1uz>(r), 1uz);
+			const auto c = compare(r2, resize<M + 1uz>(v));
+			if (c > 0 || (c == 0 && (q[0] & 1u) != 0u))
+			{
+				auto one = limbs<N>{};
+				one[0] = 1u;
+				add(q, one);
+			}
+
+			return q;
+		}
+
+	}
+
+
+	// decimal with a fixed number of decimal places held in a 128 bit integer
+	// (addition and subtraction are exact, multiplication and division are rounded half to even,
+	// transcendental functions are calculated with 36 decimal places before rounding,
+	// so they are correctly rounded unless the result is very large - over 1e15 or so for 18 decimal places)
+	template<unsigned int Scale = 18>
+	class fixed_decimal final
+	{
+
+		static_assert(Scale >= 1u && Scale <= 36u, "fixed_decimal supports between 1 and 36 decimal places");
+
+	public:
+
+		using mantissa_type = _fixed_decimal::limbs<4>; // two's complement
+
+		static constexpr auto scale = Scale;
+
+	public:
+
+		constexpr fixed_decimal() noexcept = default;
+
+		template<std::integral I>
+		fixed_decimal(I i);
+
+		fixed_decimal(double d); // as the shortest decimal representation of d, so 0.1 is 0.1
+
+		explicit fixed_decimal(std::string_view s);
+		explicit fixed_decimal(const char* s);
+		explicit fixed_decimal(const std::string& s);
+
+	public:
+
+		explicit operator double() const;
+
+		auto to_string() const -> std::string;
+
+		static auto from_mantissa(mantissa_type mantissa) noexcept -> fixed_decimal;
+		auto get_mantissa() const noexcept -> const mantissa_type&;
+
+	public:
+
+		auto operator+=(const fixed_decimal& other) -> fixed_decimal&;
+		auto operator-=(const fixed_decimal& other) -> fixed_decimal&;
+		auto operator*=(const fixed_decimal& other) -> fixed_decimal&;
+		auto operator/=(const fixed_decimal& other) -> fixed_decimal&;
+
+		friend auto operator+(fixed_decimal a, const fixed_decimal& b) -> fixed_decimal { return a += b; }
+		friend auto operator-(fixed_decimal a, const fixed_decimal& b) -> fixed_decimal { return a -= b; }
+		friend auto operator*(fixed_decimal a, const fixed_decimal& b) -> fixed_decimal { return a *= b; }
+		friend auto operator/(fixed_decimal a, const fixed_decimal& b) -> fixed_decimal { return a /= b; }
+
+		friend auto operator-(const fixed_decimal& a) -> fixed_decimal { return fixed_decimal{} - a; }
+		friend auto operator+(const fixed_decimal& a) -> fixed_decimal { return a; }
+
+		friend auto operator==(const fixed_decimal& a, const fixed_decimal& b) noexcept -> bool { return a.mantissa_ == b.mantissa_; }
+		friend auto operator<=>(const fixed_decimal& a, const fixed_decimal& b) noexcept -> std::strong_ordering
+		{
+			if (a._is_negative() != b._is_negative())
+				return a._is_negative() ? std::strong_ordering::less : std::strong_ordering::greater;
+
+			return _fixed_decimal::compare(a.mantissa_, b.mantissa_); // two's complement compares as unsigned within the same sign
+		}
+
+		friend auto operator<<(std::ostream& os, const fixed_decimal& d) -> std::ostream& { return os << d.to_string(); }
+
+	public:
+
+		// the usual <cmath> functions, found via ADL (which is what reset and the pricers rely on)
+		friend auto abs(const fixed_decimal& d) -> fixed_decimal { return d._is_negative() ? -d : d; }
+		friend auto fabs(const fixed_decimal& d) -> fixed_decimal { return abs(d); }
+
+		friend auto trunc(const fixed_decimal& d) -> fixed_decimal { return d._to_integer(_rounding::toward_zero); }
+		friend auto floor(const fixed_decimal& d) -> fixed_decimal { return d._to_integer(_rounding::down); }
+		friend auto ceil(const fixed_decimal& d) -> fixed_decimal { return d._to_integer(_rounding::up); }
+		friend auto round(const fixed_decimal& d) -> fixed_decimal { return d._to_integer(_rounding::half_away_from_zero); }
+
+		friend auto exp(const fixed_decimal& d) -> fixed_decimal { return _exp_of(d); }
+		friend auto log(const fixed_decimal& d) -> fixed_decimal { return _log_of(d); }
+
+		friend auto pow(const fixed_decimal& x, const fixed_decimal& y) -> fixed_decimal { return _pow(x, y); }
+
+		template<std::integral I>
+		friend auto pow(const fixed_decimal& x, I n) -> fixed_decimal { return _pow_integer(x, static_cast<long long>(n)); }
+
+	private:
+
+		template<unsigned int> friend class fixed_decimal;
+
+		using _work = fixed_decimal<36u>; // precision of the transcendental functions
+
+		enum class _rounding { toward_zero, down, up, half_away_from_zero, half_even };
+
+		static constexpr auto _mantissa_limbs = 4uz;
+		static constexpr auto _unit = _fixed_decimal::pow10<4>(Scale); // 1
+
+		auto _is_negative() const noexcept -> bool;
+		auto _magnitude() const noexcept -> mantissa_type;
+
+		static auto _from_magnitude(bool negative, const mantissa_type& magnitude) -> fixed_decimal;
+
+		template<std::size_t N>
+		static auto _from_wide(bool negative, const _fixed_decimal::limbs<N>& magnitude) -> fixed_decimal;
+
+		auto _to_integer(_rounding rounding) const -> fixed_decimal;
+
+		template<unsigned int S>
+		auto _round_to() const -> fixed_decimal<S>;
+
+		template<unsigned int S>
+		static auto _rescale(const fixed_decimal<S>& d) -> fixed_decimal; // exact, to more decimal places
+
+		static auto _ln2() -> const _work&;
+		static auto _ln(const fixed_decimal& d) -> _work;
+		static auto _exp(const _work& z) -> fixed_decimal;
+		static auto _exp_of(const fixed_decimal& d) -> fixed_decimal;
+		static auto _log_of(const fixed_decimal& d) -> fixed_decimal;
+		static auto _pow(const fixed_decimal& x, const fixed_decimal& y) -> fixed_decimal;
+		static auto _pow_integer(const fixed_decimal& x, long long n) -> fixed_decimal;
+		static auto _exp_of_product(const fixed_decimal& y, const _work& ln_x) -> fixed_decimal; // exp(y * ln(x)) for any y
+
+		auto _is_integer() const -> bool;
+		auto _divide(std::uint32_t n) const -> fixed_decimal; // by a small integer, cheaper than a full division
+		auto _integer_part() const -> long long; // truncated, only for small values
+
+	private:
+
+		mantissa_type mantissa_{};
+
+	};
+
+
+	template<unsigned int Scale>
+	template<std::integral I>
+	fixed_decimal<Scale>::fixed_decimal(I i)
+	{
+		const auto negative = std::is_signed_v<I> && i < 0;
+		const auto m = negative ?
+			std::uint64_t{ 0 } - static_cast<std::uint64_t>(i) :
+			static_cast<std::uint64_t>(i);
+
+		const auto magnitude = _fixed_decimal::limbs<2>{
+			static_cast<std::uint32_t>(m),
+			static_cast<std::uint32_t>(m >> 32)
+		};
+
+		*this = _from_wide(negative, _fixed_decimal::mul(magnitude, _unit));
+	}
+
+	template<unsigned int Scale>
+	fixed_decimal<Scale>::fixed_decimal(double d)
+	{
+		if (d != d || d == std::numeric_limits<double>::infinity() || d == -std::numeric_limits<double>::infinity())
+			throw std::domain_error{ "fixed_decimal can not represent NaN or infinity" };
+
+		auto buffer = std::array<char, 32>{};
+		const auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), d);
+		if (ec != std::errc{})
+			throw std::invalid_argument{ "Can not convert double to fixed_decimal" };
+
+		*this = fixed_decimal{ std::string_view{ buffer.data(), end } };
+	}
+
+	template<unsigned int Scale>
+	fixed_decimal<Scale>::fixed_decimal(std::string_view s)
+	{
+		const auto invalid = [&] { return std::invalid_argument{ "Invalid decimal: " + std::string{ s } }; };
+
+		auto i = 0uz;
+		auto negative = false;
+		if (i < s.size() && (s[i] == '-' || s[i] == '+'))
+			negative = s[i++] == '-';
+
+		// significant digits go into a wide integer, we keep track of the decimal exponent separately
+		constexpr auto max_digits = 60;
+		auto digits = _fixed_decimal::limbs<8>{};
+		auto number_of_digits = 0;
+		auto exponent = 0;
+		auto seen_digit = false;
+		auto seen_point = false;
+		auto sticky = false; // non zero digits beyond what we keep
+
+		for (; i < s.size(); ++i)
+		{
+			const auto c = s[i];
+			if (c == '.' && !seen_point)
+			{
+				seen_point = true;
+			}
+			else if (c >= '0' && c <= '9')
+			{
+				seen_digit = true;
+				if (number_of_digits < max_digits)
+				{
+					digits = _fixed_decimal::resize<8>(_fixed_decimal::mul(digits, _fixed_decimal::limbs<1>{ 10u }));
+					_fixed_decimal::add(digits, _fixed_decimal::limbs<8>{ static_cast<std::uint32_t>(c - '0') });
+					if (!_fixed_decimal::is_zero(digits))
+						++number_of_digits;
+					if (seen_point)
+						--exponent;
+				}
+				else
+				{
+					sticky = sticky || c != '0';
+					if (!seen_point)
+						++exponent;
+				}
+			}
+			else
+				break;
+		}
+
+		if (!seen_digit)
+			throw invalid();
+
+		if (i < s.size() && (s[i] == 'e' || s[i] == 'E'))
+		{
+			++i;
+			auto e = 0;
+			const auto [p, ec] = std::from_chars(s.data() + i + (i < s.size() && s[i] == '+' ? 1uz : 0uz), s.data() + s.size(), e);
+			if (ec != std::errc{} || p != s.data() + s.size())
+				throw invalid();
+			exponent += e;
+			i = s.size();
+		}
+
+		if (i != s.size())
+			throw invalid();
+
+		const auto shift = exponent + static_cast<int>(Scale);
+		if (shift >= 0)
+		{
+			if (shift > 80 && !_fixed_decimal::is_zero(digits))
+				throw std::overflow_error{ "Decimal is too large for fixed_decimal" };
+
+			const auto wide = _fixed_decimal::mul(digits, _fixed_decimal::pow10<9>(static_cast<unsigned int>(std::min(shift, 80))));
+			*this = _from_wide(negative, wide);
+		}
+		else if (-shift > 80)
+		{
+			*this = fixed_decimal{};
+		}
+		else
+		{
+			auto wide = _fixed_decimal::limbs<9>{};
+			for (auto j = 0uz; j < 8uz; ++j)
+				wide[j] = digits[j];
+			auto [q, r] = _fixed_decimal::divmod(wide, _fixed_decimal::pow10<9>(static_cast<unsigned int>(-shift)));
+			if (!_fixed_decimal::is_zero(r) || sticky)
+			{
+				// round half to even (sticky digits break a tie)
+				auto r2 = _fixed_decimal::shift_left(r, 1uz);
+				const auto c = _fixed_decimal::compare(r2, _fixed_decimal::pow10<9>(static_cast<unsigned int>(-shift)));
+				if (c > 0 || (c == 0 && (sticky || (q[0] & 1u) != 0u)))
+					_fixed_decimal::add(q, _fixed_decimal::limbs<9>{ 1u });
+			}
+			*this = _from_wide(negative, q);
+		}
+	}
+
+	template<unsigned int Scale>
+	fixed_decimal<Scale>::fixed_decimal(const char* s) :
+		fixed_decimal{ std::string_view{ s } }
+	{
+	}
+
+	template<unsigned int Scale>
+	fixed_decimal<Scale>::fixed_decimal(const std::string& s) :
+		fixed_decimal{ std::string_view{ s } }
+	{
+	}
+
+
+	template<unsigned int Scale>
+	fixed_decimal<Scale>::operator double() const
+	{
+		const auto s = to_string();
+
+		auto d = 0.0;
+		std::from_chars(s.data(), s.data() + s.size(), d); // correctly rounded
+
+		return d;
+	}
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::to_string() const -> std::string
+	{
+		// decimal digits of the magnitude, 9 at a time
+		auto m = _magnitude();
+		auto digits = std::string{};
+		do
+		{
+			auto [q, r] = _fixed_decimal::divmod(m, _fixed_decimal::limbs<1>{ 1'000'000'000u });
+			auto chunk = r[0];
+			for (auto i = 0; i < 9; ++i)
+			{
+				digits.push_back(static_cast<char>('0' + chunk % 10u));
+				chunk /= 10u;
+			}
+			m = q;
+		} while (!_fixed_decimal::is_zero(m));
+
+		while (digits.size() > Scale + 1uz && digits.back() == '0')
+			digits.pop_back();
+		while (digits.size() < Scale + 1uz)
+			digits.push_back('0');
+
+		auto result = std::string{};
+		if (_is_negative())
+			result.push_back('-');
+		for (auto i = digits.size(); i-- > Scale;)
+			result.push_back(digits[i]);
+
+		auto fraction = std::string{};
+		for (auto i = Scale; i-- > 0u;)
+			fraction.push_back(digits[i]);
+		while (!fraction.empty() && fraction.back() == '0')
+			fraction.pop_back();
+
+		if (!fraction.empty())
+		{
+			result.push_back('.');
+			result += fraction;
+		}
+
+		return result;
+	}
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::from_mantissa(mantissa_type mantissa) noexcept -> fixed_decimal
+	{
+		auto result = fixed_decimal{};
+		result.mantissa_ = std::move(mantissa);
+		return result;
+	}
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::get_mantissa() const noexcept -> const mantissa_type&
+	{
+		return mantissa_;
+	}
+
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::operator+=(const fixed_decimal& other) -> fixed_decimal&
+	{
+		const auto a_negative = _is_negative();
+		const auto b_negative = other._is_negative();
+
+		_fixed_decimal::add(mantissa_, other.mantissa_);
+
+		if (a_negative == b_negative && _is_negative() != a_negative)
+			throw std::overflow_error{ "fixed_decimal addition overflow" };
+
+		return *this;
+	}
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::operator-=(const fixed_decimal& other) -> fixed_decimal&
+	{
+		const auto a_negative = _is_negative();
+		const auto b_negative = other._is_negative();
+
+		_fixed_decimal::sub(mantissa_, other.mantissa_);
+
+		if (a_negative != b_negative && _is_negative() != a_negative)
+			throw std::overflow_error{ "fixed_decimal subtraction overflow" };
+
+		return *this;
+	}
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::operator*=(const fixed_decimal& other) -> fixed_decimal&
+	{
+		const auto negative = _is_negative() != other._is_negative();
+		const auto product = _fixed_decimal::mul(_magnitude(), other._magnitude());
+
+		*this = _from_wide(negative, _fixed_decimal::divide_round(product, _unit));
+
+		return *this;
+	}
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::operator/=(const fixed_decimal& other) -> fixed_decimal&
+	{
+		const auto negative = _is_negative() != other._is_negative();
+		const auto scaled = _fixed_decimal::mul(_magnitude(), _unit);
+
+		*this = _from_wide(negative, _fixed_decimal::divide_round(scaled, other._magnitude()));
+
+		return *this;
+	}
+
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::_is_negative() const noexcept -> bool
+	{
+		return (mantissa_[_mantissa_limbs - 1uz] >> 31) != 0u;
+	}
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::_magnitude() const noexcept -> mantissa_type
+	{
+		auto m = mantissa_;
+		if (_is_negative())
+			_fixed_decimal::negate(m);
+
+		return m;
+	}
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::_from_magnitude(bool negative, const mantissa_type& magnitude) -> fixed_decimal
+	{
+		if ((magnitude[_mantissa_limbs - 1uz] >> 31) != 0u)
+			throw std::overflow_error{ "fixed_decimal overflow" };
+
+		auto result = from_mantissa(magnitude);
+		if (negative)
+			_fixed_decimal::negate(result.mantissa_);
+
+		return result;
+	}
+
+	template<unsigned int Scale>
+	template<std::size_t N>
+	auto fixed_decimal<Scale>::_from_wide(bool negative, const _fixed_decimal::limbs<N>& magnitude) -> fixed_decimal
+	{
+		if (!_fixed_decimal::fits<_mantissa_limbs>(magnitude))
+			throw std::overflow_error{ "fixed_decimal overflow" };
+
+		return _from_magnitude(negative, _fixed_decimal::resize<_mantissa_limbs>(magnitude));
+	}
+
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::_to_integer(_rounding rounding) const -> fixed_decimal
+	{
+		const auto negative = _is_negative();
+		const auto unit = _unit;
+
+		auto [q, r] = _fixed_decimal::divmod(_magnitude(), unit);
+
+		auto up = false; // away from zero
+		if (!_fixed_decimal::is_zero(r))
+		{
+			const auto c = _fixed_decimal::compare(_fixed_decimal::shift_left(_fixed_decimal::resize<5>(r), 1uz), _fixed_decimal::resize<5>(unit));
+			switch (rounding)
+			{
+			case _rounding::toward_zero: up = false; break;
+			case _rounding::down: up = negative; break;
+			case _rounding::up: up = !negative; break;
+			case _rounding::half_away_from_zero: up = c >= 0; break;
+			case _rounding::half_even: up = c > 0 || (c == 0 && (q[0] & 1u) != 0u); break;
+			}
+		}
+
+		if (up)
+			_fixed_decimal::add(q, _fixed_decimal::limbs<4>{ 1u });
+
+		return _from_wide(negative, _fixed_decimal::mul(q, unit));
+	}
+
+	template<unsigned int Scale>
+	template<unsigned int S>
+	auto fixed_decimal<Scale>::_round_to() const -> fixed_decimal<S>
+	{
+		static_assert(S <= Scale);
+
+		const auto m = _fixed_decimal::divide_round(_magnitude(), _fixed_decimal::pow10<4>(Scale - S));
+
+		return fixed_decimal<S>::_from_wide(_is_negative(), m);
+	}
+
+	template<unsigned int Scale>
+	template<unsigned int S>
+	auto fixed_decimal<Scale>::_rescale(const fixed_decimal<S>& d) -> fixed_decimal
+	{
+		static_assert(S <= Scale);
+
+		const auto m = _fixed_decimal::mul(d._magnitude(), _fixed_decimal::pow10<4>(Scale - S));
+
+		return _from_wide(d._is_negative(), m);
+	}
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::_is_integer() const -> bool
+	{
+		return _fixed_decimal::is_zero(_fixed_decimal::divmod(_magnitude(), _unit).second);
+	}
+
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::_divide(std::uint32_t n) const -> fixed_decimal
+	{
+		return _from_wide(_is_negative(), _fixed_decimal::divide_round(_magnitude(), _fixed_decimal::limbs<1>{ n }));
+	}
+
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::_integer_part() const -> long long
+	{
+		const auto q = _fixed_decimal::divmod(_magnitude(), _unit).first;
+		const auto n = static_cast<long long>((std::uint64_t{ q[1] } << 32) | q[0]);
+
+		return _is_negative() ? -n : n;
+	}
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::_ln2() -> const _work&
+	{
+		static const auto ln2 = _work{ "0.693147180559945309417232121458176568" };
+		return ln2;
+	}
+
+	// ln(d) = e * ln(2) + ln(f), where d = f * 2^e with f in [0.75, 1.5)
+	// and ln(f) = 2 * atanh((f - 1) / (f + 1)) = 2 * (s + s^3 / 3 + s^5 / 5 + ...)
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::_ln(const fixed_decimal& d) -> _work
+	{
+		if (!(d > fixed_decimal{}))
+			throw std::domain_error{ "Logarithm of a non positive number" };
+
+		// d at 36 decimal places might not fit into 128 bits, so we work with a wider integer
+		const auto x = _fixed_decimal::mul(d._magnitude(), _fixed_decimal::pow10<4>(36u - Scale));
+		const auto one = _fixed_decimal::pow10<8>(36u);
+
+		auto e = static_cast<int>(_fixed_decimal::bit_length(x)) - static_cast<int>(_fixed_decimal::bit_length(one));
+		auto f = e >= 0 ?
+			_fixed_decimal::divide_round(x, _fixed_decimal::shift_left(_fixed_decimal::limbs<8>{ 1u }, static_cast<std::size_t>(e))) :
+			_fixed_decimal::shift_left(x, static_cast<std::size_t>(-e));
+
+		// now f is in (0.5, 2), bring it to [0.75, 1.5)
+		auto three_quarters = _fixed_decimal::resize<8>(_fixed_decimal::mul(one, _fixed_decimal::limbs<1>{ 3u }));
+		three_quarters = _fixed_decimal::divmod(three_quarters, _fixed_decimal::limbs<1>{ 4u }).first;
+		auto three_halves = _fixed_decimal::resize<8>(_fixed_decimal::mul(one, _fixed_decimal::limbs<1>{ 3u }));
+		three_halves = _fixed_decimal::divmod(three_halves, _fixed_decimal::limbs<1>{ 2u }).first;
+		if (_fixed_decimal::compare(f, three_quarters) < 0)
+		{
+			f = _fixed_decimal::shift_left(f, 1uz);
+			--e;
+		}
+		else if (_fixed_decimal::compare(f, three_halves) >= 0)
+		{
+			f = _fixed_decimal::divide_round(f, _fixed_decimal::limbs<1>{ 2u });
+			++e;
+		}
+
+		const auto w_one = _work{ 1 };
+		const auto w_f = _work::_from_wide(false, f);
+		const auto s = (w_f - w_one) / (w_f + w_one);
+		const auto s2 = s * s;
+
+		auto sum = s;
+		auto term = s;
+		for (auto n = 3; ; n += 2)
+		{
+			term *= s2;
+			const auto t = term._divide(static_cast<std::uint32_t>(n));
+			if (t == _work{})
+				break;
+			sum += t;
+		}
+
+		return sum * _work{ 2 } + _work{ e } * _ln2();
+	}
+
+	// exp(z) = 2^k * exp(r), where z = k * ln(2) + r and |r| <= ln(2) / 2, and exp(r) is from a Taylor series
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::_exp(const _work& z) -> fixed_decimal
+	{
+		// outside of these we either overflow or round to 0 anyway
+		if (z > _work{ 89 })
+			throw std::overflow_error{ "fixed_decimal exp overflow" };
+		if (z < _work{ -static_cast<int>(Scale) * 3 - 2 })
+			return fixed_decimal{};
+
+		const auto k_ = round(z / _ln2());
+		const auto k = static_cast<int>(k_._integer_part());
+		constexpr auto squarings = 8; // exp(r) = exp(r / 2^8)^(2^8), so the series converges much faster
+		const auto r = (z - k_ * _ln2())._divide(1u << squarings);
+
+		auto sum = _work{ 1 };
+		auto term = _work{ 1 };
+		for (auto n = 1; ; ++n)
+		{
+			term = (term * r)._divide(static_cast<std::uint32_t>(n));
+			if (term == _work{})
+				break;
+			sum += term;
+		}
+		for (auto i = 0; i < squarings; ++i)
+			sum *= sum;
+
+		// scale 2^k * sum from 36 to Scale decimal places in one rounding
+		const auto m = _fixed_decimal::resize<9>(sum._magnitude());
+		if (k >= 0)
+		{
+			const auto scaled = _fixed_decimal::shift_left(m, static_cast<std::size_t>(k));
+			return _from_wide(false, _fixed_decimal::divide_round(scaled, _fixed_decimal::pow10<4>(36u - Scale)));
+		}
+		else
+		{
+			const auto divisor = _fixed_decimal::shift_left(_fixed_decimal::resize<9>(_fixed_decimal::pow10<4>(36u - Scale)), static_cast<std::size_t>(-k));
+			return _from_wide(false, _fixed_decimal::divide_round(m, divisor));
+		}
+	}
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::_exp_of(const fixed_decimal& d) -> fixed_decimal
+	{
+		return _exp(_work::_rescale(d));
+	}
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::_log_of(const fixed_decimal& d) -> fixed_decimal
+	{
+		return _ln(d).template _round_to<Scale>();
+	}
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::_pow(const fixed_decimal& x, const fixed_decimal& y) -> fixed_decimal
+	{
+		if (y == fixed_decimal{})
+			return fixed_decimal{ 1 };
+
+		if (y._is_integer() && x._is_integer() && abs(y) <= fixed_decimal{ 64 }) // exact (the usual 10^n falls here)
+			return _pow_integer(x, y._integer_part());
+
+		if (x == fixed_decimal{})
+		{
+			if (y > fixed_decimal{})
+				return fixed_decimal{};
+			throw std::domain_error{ "Zero to a negative power" };
+		}
+
+		if (x < fixed_decimal{})
+		{
+			if (!y._is_integer())
+				throw std::domain_error{ "Negative number to a non integer power" };
+
+			const auto odd = !(y / fixed_decimal{ 2 })._is_integer();
+			const auto result = _exp_of_product(y, _ln(-x));
+			return odd ? -result : result;
+		}
+
+		return _exp_of_product(y, _ln(x));
+	}
+
+	// y itself might not fit into _work (which only goes to about 170), so its integer part
+	// is multiplied by ln(x) in a wider integer, and only a product exp can do anything with is brought back
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::_exp_of_product(const fixed_decimal& y, const _work& ln_x) -> fixed_decimal
+	{
+		const auto [n, f] = _fixed_decimal::divmod(y._magnitude(), _unit);
+		const auto negative = y._is_negative() != ln_x._is_negative();
+
+		const auto integer_product = _fixed_decimal::mul(n, ln_x._magnitude()); // at 36 decimal places
+		const auto limit = _fixed_decimal::resize<8>(_fixed_decimal::mul(_fixed_decimal::pow10<4>(36u), _fixed_decimal::limbs<1>{ 100u }));
+		if (_fixed_decimal::compare(integer_product, limit) > 0) // exp overflows or rounds to 0 whatever the fraction adds
+		{
+			if (!negative)
+				throw std::overflow_error{ "fixed_decimal exp overflow" };
+			return fixed_decimal{};
+		}
+
+		const auto fraction = _work::_rescale(_from_magnitude(y._is_negative(), f)) * ln_x;
+
+		return _exp(_work::_from_wide(negative, integer_product) + fraction);
+	}
+
+	template<unsigned int Scale>
+	auto fixed_decimal<Scale>::_pow_integer(const fixed_decimal& x, long long n) -> fixed_decimal
+	{
+		if (!x._is_integer()) // repeated rounding would not be correctly rounded
+			return _pow(x, fixed_decimal{ n });
+
+		auto result = fixed_decimal{ 1 };
+		auto base = x;
+		auto e = n < 0 ? 0ull - static_cast<unsigned long long>(n) : static_cast<unsigned long long>(n);
+		while (e != 0ull)
+		{
+			if ((e & 1ull) != 0ull)
+				result *= base;
+			e >>= 1;
+			if (e != 0ull)
+				base *= base;
+		}
+
+		return n < 0 ? fixed_decimal{ 1 } / result : result;
+	}
+
+}
+
+
+template<unsigned int Scale>
+class std::numeric_limits<debt_security::fixed_decimal<Scale>>
+{
+
+	using type = debt_security::fixed_decimal<Scale>;
+
+	static constexpr auto _integer_digits10 = 38 - static_cast<int>(Scale); // every integer of these many digits fits, as 10^38 < 2^127
+
+public:
+
+	static constexpr auto is_specialized = true;
+	static constexpr auto is_signed = true;
+	static constexpr auto is_integer = false;
+	static constexpr auto is_exact = false; // division and multiplication round
+	static constexpr auto has_infinity = false;
+	static constexpr auto has_quiet_NaN = false;
+	static constexpr auto has_signaling_NaN = false;
+	static constexpr auto is_bounded = true;
+	static constexpr auto is_modulo = false;
+	static constexpr auto is_iec559 = false;
+	static constexpr auto radix = 10;
+	static constexpr auto digits10 = _integer_digits10 + static_cast<int>(Scale);
+	static constexpr auto max_digits10 = 39;
+	static constexpr auto round_style = std::round_to_nearest;
+
+	static auto min() noexcept -> type { return type::from_mantissa({ 1u, 0u, 0u, 0u }); } // smallest positive
+	static auto max() noexcept -> type { return type::from_mantissa({ 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x7FFFFFFFu }); }
+	static auto lowest() noexcept -> type { return type::from_mantissa({ 1u, 0u, 0u, 0x80000000u }); }
+	static auto epsilon() noexcept -> type { return min(); }
+	static auto round_error() noexcept -> type { return type{ "0.5" }; }
+
+};
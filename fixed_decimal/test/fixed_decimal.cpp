@@ -0,0 +1,199 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <fixed_decimal.h>
+
+#include <resets_math.h>
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+
+namespace debt_security
+{
+
+	using decimal = fixed_decimal<18>;
+
+
+	TEST(fixed_decimal, constructor1)
+	{
+		EXPECT_EQ(decimal{}.to_string(), "0");
+		EXPECT_EQ(decimal{ 100 }.to_string(), "100");
+		EXPECT_EQ(decimal{ -7 }.to_string(), "-7");
+		EXPECT_EQ(decimal{ 1'000'000'000'000ull }.to_string(), "1000000000000");
+	}
+
+	TEST(fixed_decimal, constructor2)
+	{
+		EXPECT_EQ(decimal{ "753.315323" }.to_string(), "753.315323");
+		EXPECT_EQ(decimal{ "-0.1436" }.to_string(), "-0.1436");
+		EXPECT_EQ(decimal{ "1e-14" }.to_string(), "0.00000000000001");
+		EXPECT_EQ(decimal{ "1.5E3" }.to_string(), "1500");
+		EXPECT_EQ(decimal{ "+.25" }.to_string(), "0.25");
+		EXPECT_EQ(decimal{ "0.0000000000000000005" }, decimal{}); // half to even
+		EXPECT_EQ(decimal{ "0.0000000000000000015" }.to_string(), "0.000000000000000002");
+		EXPECT_EQ(decimal{ "0.00000000000000000050001" }.to_string(), "0.000000000000000001");
+
+		EXPECT_THROW(decimal{ "" }, invalid_argument);
+		EXPECT_THROW(decimal{ "1.2.3" }, invalid_argument);
+		EXPECT_THROW(decimal{ "abc" }, invalid_argument);
+		EXPECT_THROW(decimal{ "1e30" }, overflow_error);
+	}
+
+	TEST(fixed_decimal, constructor3)
+	{
+		EXPECT_EQ(decimal{ 0.1 }, decimal{ "0.1" });
+		EXPECT_EQ(decimal{ 14.36 }, decimal{ "14.36" });
+		EXPECT_EQ(decimal{ -2.5 }, decimal{ "-2.5" });
+		EXPECT_EQ(static_cast<double>(decimal{ "0.1436" }), 0.1436);
+	}
+
+	TEST(fixed_decimal, arithmetic1)
+	{
+		const auto a = decimal{ "1.1" };
+		const auto b = decimal{ "2.2" };
+
+		EXPECT_EQ(a + b, decimal{ "3.3" }); // unlike double
+		EXPECT_EQ(a - b, decimal{ "-1.1" });
+		EXPECT_EQ(a * b, decimal{ "2.42" });
+		EXPECT_EQ(b / a, decimal{ 2 });
+		EXPECT_EQ(-a, decimal{ "-1.1" });
+		EXPECT_EQ(a * 2, b);
+		EXPECT_EQ(decimal{ 1 } / 3, decimal{ "0.333333333333333333" });
+		EXPECT_EQ(decimal{ 2 } / 3, decimal{ "0.666666666666666667" });
+		EXPECT_EQ(decimal{ -2 } / 3, decimal{ "-0.666666666666666667" });
+		EXPECT_EQ(decimal{ 504 } / 252, decimal{ 2 });
+
+		EXPECT_THROW(a / decimal{}, domain_error);
+		EXPECT_THROW(numeric_limits<decimal>::max() + a, overflow_error);
+		EXPECT_THROW(numeric_limits<decimal>::max() * 2, overflow_error);
+	}
+
+	TEST(fixed_decimal, comparison1)
+	{
+		EXPECT_LT(decimal{ -1 }, decimal{ "-0.5" });
+		EXPECT_LT(decimal{ "-0.5" }, decimal{});
+		EXPECT_LT(decimal{}, decimal{ "0.000000000000000001" });
+		EXPECT_GT(decimal{ 2 }, decimal{ "1.999999999999999999" });
+		EXPECT_EQ(decimal{ "-0" }, decimal{});
+
+		auto m = map<decimal, int>{};
+		m[decimal{ "0.1436" }] = 1;
+		m[decimal{ 0.1436 }] = 2;
+		EXPECT_EQ(m.size(), 1uz);
+	}
+
+	TEST(fixed_decimal, rounding1)
+	{
+		EXPECT_EQ(trunc(decimal{ "2.7" }), decimal{ 2 });
+		EXPECT_EQ(trunc(decimal{ "-2.7" }), decimal{ -2 });
+		EXPECT_EQ(floor(decimal{ "-2.1" }), decimal{ -3 });
+		EXPECT_EQ(ceil(decimal{ "2.1" }), decimal{ 3 });
+		EXPECT_EQ(round(decimal{ "2.5" }), decimal{ 3 });
+		EXPECT_EQ(round(decimal{ "-2.5" }), decimal{ -3 });
+		EXPECT_EQ(round(decimal{ "2.4999" }), decimal{ 2 });
+		EXPECT_EQ(abs(decimal{ "-2.5" }), decimal{ "2.5" });
+	}
+
+	TEST(fixed_decimal, reset1)
+	{
+		EXPECT_EQ(reset::trunc_dp(decimal{ 532 } / 252, 14u), decimal{ "2.11111111111111" });
+		EXPECT_EQ(reset::trunc_dp(decimal{ "753.3153239" }, 6u), decimal{ "753.315323" });
+		EXPECT_EQ(reset::round_dp(decimal{ "2.2541150" }, 6u), decimal{ "2.254115" });
+		EXPECT_EQ(reset::round_dp(decimal{ "2.2541155" }, 6u), decimal{ "2.254116" });
+		EXPECT_EQ(reset::from_percent(decimal{ "14.36" }), decimal{ "0.1436" });
+	}
+
+	TEST(fixed_decimal, pow1)
+	{
+		EXPECT_EQ(pow(decimal{ 10 }, 14), decimal{ "1e14" });
+		EXPECT_EQ(pow(decimal{ 10 }, -6), decimal{ "0.000001" });
+		EXPECT_EQ(pow(decimal{ 10 }, decimal{ 3 }), decimal{ 1000 });
+		EXPECT_EQ(pow(decimal{ -2 }, 3), decimal{ -8 });
+		EXPECT_EQ(pow(decimal{ "1.5" }, 2), decimal{ "2.25" });
+		EXPECT_EQ(pow(decimal{ 4 }, decimal{ "0.5" }), decimal{ 2 });
+		EXPECT_EQ(pow(decimal{ 2 }, decimal{ "0.5" }), decimal{ "1.414213562373095049" });
+		EXPECT_EQ(pow(decimal{ "1.1436" }, decimal{ "2.11111111111111" }), decimal{ "1.327465364597531043" });
+
+		EXPECT_THROW(pow(decimal{ -2 }, decimal{ "0.5" }), domain_error);
+		EXPECT_THROW(pow(decimal{}, -1), domain_error);
+	}
+
+	TEST(fixed_decimal, pow2)
+	{
+		// powers which would not fit into the precision of the working type, even if the result does
+		EXPECT_EQ(pow(decimal{ "1.0001" }, decimal{ 200 }), decimal{ "1.020200319893934138" });
+		EXPECT_EQ(pow(decimal{ "1.0001" }, 200), decimal{ "1.020200319893934138" });
+		EXPECT_EQ(pow(decimal{ "1.0001" }, decimal{ "200.5" }), decimal{ "1.020251328634742193" });
+		EXPECT_EQ(pow(decimal{ "1.0001" }, decimal{ -200 }), decimal{ "0.980199653440576966" });
+		EXPECT_EQ(pow(decimal{ "1.0001" }, decimal{ 1'000 }), decimal{ "1.105165392603232697" });
+
+		EXPECT_EQ(pow(decimal{ "0.5" }, decimal{ 1'000 }), decimal{});
+		EXPECT_EQ(pow(decimal{ "-0.5" }, decimal{ 1'001 }), decimal{});
+		EXPECT_THROW(pow(decimal{ "2.5" }, decimal{ 1'000 }), overflow_error);
+	}
+
+	TEST(fixed_decimal, exp_log1)
+	{
+		EXPECT_EQ(exp(decimal{}), decimal{ 1 });
+		EXPECT_EQ(exp(decimal{ 1 }), decimal{ "2.718281828459045235" });
+		EXPECT_EQ(exp(decimal{ -1 }), decimal{ "0.367879441171442322" });
+		EXPECT_EQ(exp(decimal{ 20 }), decimal{ "485165195.409790277969106831" });
+		EXPECT_EQ(exp(decimal{ -100 }), decimal{});
+		EXPECT_THROW(exp(decimal{ 50 }), overflow_error);
+
+		EXPECT_EQ(log(decimal{ 1 }), decimal{});
+		EXPECT_EQ(log(decimal{ 2 }), decimal{ "0.693147180559945309" });
+		EXPECT_EQ(log(decimal{ 10 }), decimal{ "2.302585092994045684" });
+		EXPECT_EQ(log(decimal{ "0.5" }), decimal{ "-0.693147180559945309" });
+		EXPECT_EQ(log(decimal{ "1e-18" }), decimal{ "-41.446531673892822312" });
+		EXPECT_THROW(log(decimal{}), domain_error);
+	}
+
+	TEST(fixed_decimal, numeric_limits1)
+	{
+		EXPECT_TRUE(numeric_limits<decimal>::is_specialized);
+		EXPECT_EQ(numeric_limits<decimal>::epsilon(), decimal{ "1e-18" });
+		EXPECT_EQ(numeric_limits<decimal>::max().to_string(), "170141183460469231731.687303715884105727");
+		EXPECT_EQ(numeric_limits<decimal>::lowest(), -numeric_limits<decimal>::max());
+
+		// 20 integer digits and 18 decimal places
+		EXPECT_EQ(numeric_limits<decimal>::digits10, 38);
+		EXPECT_EQ(decimal{ "99999999999999999999.999999999999999999" }.to_string(), "99999999999999999999.999999999999999999");
+		EXPECT_EQ(numeric_limits<fixed_decimal<36>>::digits10, 38);
+		EXPECT_EQ(fixed_decimal<36>{ "99.999999999999999999999999999999999999" }.to_string(), "99.999999999999999999999999999999999999");
+	}
+
+	TEST(fixed_decimal, ostream1)
+	{
+		auto os = ostringstream{};
+		os << decimal{ "-903.075616" };
+		EXPECT_EQ(os.str(), "-903.075616");
+	}
+
+}
@@ -0,0 +1,504 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <concepts>
+#include <vector>
+#include <optional>
+#include <variant>
+#include <utility>
+#include <iterator>
+#include <cmath>
+#include <stdexcept>
+
+#include <quote.h>
+
+#include "work_stealing_pool.h"
+
+
+namespace debt_security
+{
+
+	// a point of a (maturity x yield x settlement) grid, as indices into its axes
+	struct grid_point final
+	{
+		std::size_t maturity;
+		std::size_t yield;
+		std::size_t settlement;
+
+		friend auto operator==(const grid_point&, const grid_point&) noexcept -> bool = default;
+	};
+
+
+	// instruments (usually one per maturity) at each of the yields under each of the quotes (usually one per settlement date)
+	// (points are numbered by maturity, then yield, then settlement, and every scan reports them in that order)
+	template<typename Instrument, typename T = double>
+	class yield_grid final
+	{
+
+	public:
+
+		explicit yield_grid(
+			std::vector<Instrument> instruments,
+			std::vector<T> yields,
+			std::vector<quote<T>> quotes
+		);
+
+	public:
+
+		auto size() const noexcept -> std::size_t;
+
+		auto point(std::size_t index) const -> grid_point;
+		auto index(const grid_point& point) const -> std::size_t;
+
+		// price from a yield methodology (like ANBIMA<T>) at the given point
+		// (one point at a time - scans go through grid_pricer, which does what it can once per instrument and quote)
+		template<typename Methodology>
+		auto price(const Methodology& methodology, std::size_t index) const -> T;
+
+	public:
+
+		auto get_instruments() const noexcept -> const std::vector<Instrument>&;
+		auto get_yields() const noexcept -> const std::vector<T>&;
+		auto get_quotes() const noexcept -> const std::vector<quote<T>>&;
+
+	private:
+
+		std::vector<Instrument> instruments_;
+		std::vector<T> yields_;
+		std::vector<quote<T>> quotes_;
+
+	};
+
+
+	// a methodology (like ANBIMA<T>) which can work out the flows of an instrument under a quote once,
+	// and then price them at any yield
+	template<typename Methodology, typename Instrument, typename T>
+	concept precomputing_methodology = requires(const Methodology& m, const Instrument& instrument, const quote<T>& q, const T& yield)
+	{
+		{ m.price(yield, m.precompute_flows(instrument, q), q) } -> std::convertible_to<T>;
+	};
+
+
+	template<typename Methodology, typename Instrument, typename T>
+	struct _precomputed_flows final
+	{
+		using type = std::monostate; // nothing to keep
+	};
+
+	template<typename Methodology, typename Instrument, typename T>
+		requires precomputing_methodology<Methodology, Instrument, T>
+	struct _precomputed_flows<Methodology, Instrument, T> final
+	{
+		using type = decltype(std::declval<const Methodology&>().precompute_flows(std::declval<const Instrument&>(), std::declval<const quote<T>&>()));
+	};
+
+
+	// prices at the points of a grid, with the flows of each (instrument, quote) worked out once up front if the methodology can do that,
+	// so the threads of a scan do not all go back to the (shared and locked) lookup of business day indices for every point
+	template<typename Instrument, typename T, typename Methodology>
+	class grid_pricer final
+	{
+
+	public:
+
+		grid_pricer(
+			work_stealing_pool& pool,
+			const yield_grid<Instrument, T>& grid,
+			const Methodology& methodology
+		);
+
+	public:
+
+		auto operator()(std::size_t index) const -> T;
+
+	private:
+
+		const yield_grid<Instrument, T>* grid_;
+		const Methodology* methodology_;
+
+		std::vector<typename _precomputed_flows<Methodology, Instrument, T>::type> flows_; // by maturity, then settlement
+
+	};
+
+
+	// reducers fold the values of consecutive points into a result, and then merge the results of consecutive ranges,
+	// always in the order of the points, so the outcome does not depend on how the work was spread over the threads
+	template<typename R, typename V>
+	concept grid_reducer = requires(const R& r, typename R::result_type& result, std::size_t index, V value)
+	{
+		{ r.empty() } -> std::same_as<typename R::result_type>;
+		r.add(result, index, std::move(value));
+		r.merge(result, std::move(result));
+	};
+
+
+	// all values in the order of the points (the full price table)
+	template<typename V>
+	struct table_reducer final
+	{
+		using result_type = std::vector<V>;
+
+		auto empty() const -> result_type;
+		auto add(result_type& result, std::size_t index, V value) const -> void;
+		auto merge(result_type& result, result_type&& other) const -> void;
+	};
+
+
+	// the total of all values (grouped by the ranges of the scan, so for doubles the same total for the same grain however many threads)
+	template<typename V>
+	struct sum_reducer final
+	{
+		using result_type = V;
+
+		auto empty() const -> result_type;
+		auto add(result_type& result, std::size_t index, V value) const -> void;
+		auto merge(result_type& result, result_type&& other) const -> void;
+	};
+
+
+	template<typename V>
+	struct grid_max final
+	{
+		std::optional<std::size_t> index; // empty for an empty grid
+		V value;
+	};
+
+	// the largest value and the first point it is at (for example the largest decimal vs binary difference)
+	template<typename V>
+	struct max_reducer final
+	{
+		using result_type = grid_max<V>;
+
+		auto empty() const -> result_type;
+		auto add(result_type& result, std::size_t index, V value) const -> void;
+		auto merge(result_type& result, result_type&& other) const -> void;
+	};
+
+
+	// reduces evaluate(index) over [0, size) on the pool
+	// (grain is the number of points in a task - big enough to make stealing rare, small enough to balance the load)
+	template<typename Evaluate, typename Reducer>
+	auto scan(
+		work_stealing_pool& pool,
+		std::size_t size,
+		Evaluate&& evaluate,
+		const Reducer& reducer,
+		std::size_t grain = 64uz
+	) -> typename Reducer::result_type;
+
+	// prices from the methodology over the whole grid
+	template<typename Instrument, typename T, typename Methodology, typename Reducer>
+	auto scan_prices(
+		work_stealing_pool& pool,
+		const yield_grid<Instrument, T>& grid,
+		const Methodology& methodology,
+		const Reducer& reducer,
+		std::size_t grain = 64uz
+	) -> typename Reducer::result_type;
+
+	// |price1 - price2| (in double) at the same points of two grids of the same shape,
+	// usually the same instruments in a decimal type and in double
+	template<typename Instrument1, typename T1, typename Methodology1, typename Instrument2, typename T2, typename Methodology2, typename Reducer>
+	auto scan_price_differences(
+		work_stealing_pool& pool,
+		const yield_grid<Instrument1, T1>& grid1,
+		const Methodology1& methodology1,
+		const yield_grid<Instrument2, T2>& grid2,
+		const Methodology2& methodology2,
+		const Reducer& reducer,
+		std::size_t grain = 64uz
+	) -> typename Reducer::result_type;
+
+
+	template<typename Instrument, typename T>
+	yield_grid<Instrument, T>::yield_grid(
+		std::vector<Instrument> instruments,
+		std::vector<T> yields,
+		std::vector<quote<T>> quotes
+	) :
+		instruments_{ std::move(instruments) },
+		yields_{ std::move(yields) },
+		quotes_{ std::move(quotes) }
+	{
+	}
+
+
+	template<typename Instrument, typename T>
+	auto yield_grid<Instrument, T>::size() const noexcept -> std::size_t
+	{
+		return instruments_.size() * yields_.size() * quotes_.size();
+	}
+
+
+	template<typename Instrument, typename T>
+	auto yield_grid<Instrument, T>::point(std::size_t index) const -> grid_point
+	{
+		if (index >= size())
+			throw std::out_of_range{ "Point is not on the grid" };
+
+		const auto settlement = index % quotes_.size();
+		index /= quotes_.size();
+
+		return grid_point{ index / yields_.size(), index % yields_.size(), settlement };
+	}
+
+	template<typename Instrument, typename T>
+	auto yield_grid<Instrument, T>::index(const grid_point& point) const -> std::size_t
+	{
+		if (point.maturity >= instruments_.size() || point.yield >= yields_.size() || point.settlement >= quotes_.size())
+			throw std::out_of_range{ "Point is not on the grid" };
+
+		return (point.maturity * yields_.size() + point.yield) * quotes_.size() + point.settlement;
+	}
+
+
+	template<typename Instrument, typename T>
+	template<typename Methodology>
+	auto yield_grid<Instrument, T>::price(const Methodology& methodology, std::size_t index) const -> T
+	{
+		const auto p = point(index);
+
+		return methodology.price(yields_[p.yield], instruments_[p.maturity], quotes_[p.settlement]);
+	}
+
+
+	template<typename Instrument, typename T, typename Methodology>
+	grid_pricer<Instrument, T, Methodology>::grid_pricer(
+		work_stealing_pool& pool,
+		const yield_grid<Instrument, T>& grid,
+		const Methodology& methodology
+	) :
+		grid_{ &grid },
+		methodology_{ &methodology },
+		flows_{}
+	{
+		if constexpr (precomputing_methodology<Methodology, Instrument, T>)
+		{
+			const auto& instruments = grid.get_instruments();
+			const auto& quotes = grid.get_quotes();
+
+			flows_.resize(instruments.size() * quotes.size());
+			pool.parallel_for(
+				flows_.size(),
+				1uz,
+				[&](std::size_t begin, std::size_t end)
+				{
+					for (auto i = begin; i < end; ++i)
+						flows_[i] = methodology.precompute_flows(instruments[i / quotes.size()], quotes[i % quotes.size()]);
+				}
+			);
+		}
+	}
+
+
+	template<typename Instrument, typename T, typename Methodology>
+	auto grid_pricer<Instrument, T, Methodology>::operator()(std::size_t index) const -> T
+	{
+		if constexpr (precomputing_methodology<Methodology, Instrument, T>)
+		{
+			const auto p = grid_->point(index);
+			const auto& quote = grid_->get_quotes()[p.settlement];
+
+			return methodology_->price(grid_->get_yields()[p.yield], flows_[p.maturity * grid_->get_quotes().size() + p.settlement], quote);
+		}
+		else
+			return grid_->price(*methodology_, index);
+	}
+
+
+	template<typename Instrument, typename T>
+	auto yield_grid<Instrument, T>::get_instruments() const noexcept -> const std::vector<Instrument>&
+	{
+		return instruments_;
+	}
+
+	template<typename Instrument, typename T>
+	auto yield_grid<Instrument, T>::get_yields() const noexcept -> const std::vector<T>&
+	{
+		return yields_;
+	}
+
+	template<typename Instrument, typename T>
+	auto yield_grid<Instrument, T>::get_quotes() const noexcept -> const std::vector<quote<T>>&
+	{
+		return quotes_;
+	}
+
+
+	template<typename V>
+	auto table_reducer<V>::empty() const -> result_type
+	{
+		return result_type{};
+	}
+
+	template<typename V>
+	auto table_reducer<V>::add(result_type& result, std::size_t, V value) const -> void
+	{
+		result.push_back(std::move(value));
+	}
+
+	template<typename V>
+	auto table_reducer<V>::merge(result_type& result, result_type&& other) const -> void
+	{
+		result.insert(result.end(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+	}
+
+
+	template<typename V>
+	auto sum_reducer<V>::empty() const -> result_type
+	{
+		return V{ 0 };
+	}
+
+	template<typename V>
+	auto sum_reducer<V>::add(result_type& result, std::size_t, V value) const -> void
+	{
+		result += value;
+	}
+
+	template<typename V>
+	auto sum_reducer<V>::merge(result_type& result, result_type&& other) const -> void
+	{
+		result += other;
+	}
+
+
+	template<typename V>
+	auto max_reducer<V>::empty() const -> result_type
+	{
+		return result_type{ std::nullopt, V{} };
+	}
+
+	template<typename V>
+	auto max_reducer<V>::add(result_type& result, std::size_t index, V value) const -> void
+	{
+		if (!result.index || result.value < value) // ties keep the earlier point
+		{
+			result.index = index;
+			result.value = std::move(value);
+		}
+	}
+
+	template<typename V>
+	auto max_reducer<V>::merge(result_type& result, result_type&& other) const -> void
+	{
+		if (other.index)
+			add(result, *other.index, std::move(other.value));
+	}
+
+
+	template<typename Evaluate, typename Reducer>
+	auto scan(
+		work_stealing_pool& pool,
+		std::size_t size,
+		Evaluate&& evaluate,
+		const Reducer& reducer,
+		std::size_t grain
+	) -> typename Reducer::result_type
+	{
+		using result_type = typename Reducer::result_type;
+
+		static_assert(grid_reducer<Reducer, decltype(evaluate(std::size_t{}))>);
+
+		if (grain == 0uz)
+			throw std::invalid_argument{ "Grain must be positive" };
+
+		// one result per range, merged in order once all of them are done
+		auto results = std::vector<std::optional<result_type>>((size + grain - 1uz) / grain);
+
+		pool.parallel_for(
+			size,
+			grain,
+			[&](std::size_t begin, std::size_t end)
+			{
+				auto result = reducer.empty();
+				for (auto i = begin; i < end; ++i)
+					reducer.add(result, i, evaluate(i));
+
+				results[begin / grain].emplace(std::move(result));
+			}
+		);
+
+		auto result = reducer.empty();
+		for (auto& r : results)
+			reducer.merge(result, std::move(*r));
+
+		return result;
+	}
+
+
+	template<typename Instrument, typename T, typename Methodology, typename Reducer>
+	auto scan_prices(
+		work_stealing_pool& pool,
+		const yield_grid<Instrument, T>& grid,
+		const Methodology& methodology,
+		const Reducer& reducer,
+		std::size_t grain
+	) -> typename Reducer::result_type
+	{
+		const auto pricer = grid_pricer{ pool, grid, methodology };
+
+		return scan(
+			pool,
+			grid.size(),
+			pricer,
+			reducer,
+			grain
+		);
+	}
+
+
+	template<typename Instrument1, typename T1, typename Methodology1, typename Instrument2, typename T2, typename Methodology2, typename Reducer>
+	auto scan_price_differences(
+		work_stealing_pool& pool,
+		const yield_grid<Instrument1, T1>& grid1,
+		const Methodology1& methodology1,
+		const yield_grid<Instrument2, T2>& grid2,
+		const Methodology2& methodology2,
+		const Reducer& reducer,
+		std::size_t grain
+	) -> typename Reducer::result_type
+	{
+		if (grid1.get_instruments().size() != grid2.get_instruments().size() ||
+			grid1.get_yields().size() != grid2.get_yields().size() ||
+			grid1.get_quotes().size() != grid2.get_quotes().size())
+			throw std::invalid_argument{ "Grids must have the same shape" };
+
+		const auto pricer1 = grid_pricer{ pool, grid1, methodology1 };
+		const auto pricer2 = grid_pricer{ pool, grid2, methodology2 };
+
+		return scan(
+			pool,
+			grid1.size(),
+			[&](std::size_t i)
+			{
+				return std::abs(static_cast<double>(pricer1(i)) - static_cast<double>(pricer2(i)));
+			},
+			reducer,
+			grain
+		);
+	}
+
+}
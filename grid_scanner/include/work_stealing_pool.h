@@ -0,0 +1,280 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <optional>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+
+namespace debt_security
+{
+
+	// a fixed set of threads for parallel loops, where each thread starts with its own contiguous share of the work
+	// and takes work from the back of the others once it runs out
+	// (the calling thread works too, so a pool of 1 runs everything on the caller)
+	class work_stealing_pool final
+	{
+
+	public:
+
+		explicit work_stealing_pool(unsigned int threads = std::thread::hardware_concurrency());
+
+		work_stealing_pool(const work_stealing_pool&) = delete;
+		work_stealing_pool(work_stealing_pool&&) = delete;
+
+		~work_stealing_pool();
+
+		auto operator=(const work_stealing_pool&) -> work_stealing_pool& = delete;
+		auto operator=(work_stealing_pool&&) -> work_stealing_pool& = delete;
+
+	public:
+
+		auto size() const noexcept -> unsigned int;
+
+		// f(begin, end) for consecutive ranges of (up to) grain indices covering [0, n),
+		// returns once all of them are done (and rethrows the first exception thrown by f, if any)
+		// (one loop at a time - the pool is not reentrant)
+		template<typename F>
+		auto parallel_for(std::size_t n, std::size_t grain, F&& f) -> void;
+
+	private:
+
+		using _range = std::pair<std::size_t, std::size_t>;
+
+		struct _queue final
+		{
+			std::mutex mutex{};
+			std::deque<_range> ranges{};
+		};
+
+		struct _loop final
+		{
+			void (*invoke)(void*, std::size_t, std::size_t);
+			void* f;
+
+			std::atomic<std::size_t> remaining; // ranges not done yet
+			std::atomic<bool> failed{ false };
+			std::mutex error_mutex{};
+			std::exception_ptr error{};
+		};
+
+		auto _work(unsigned int worker, _loop& loop) -> void;
+
+		auto _next(unsigned int worker) -> std::optional<_range>;
+
+		auto _run(unsigned int worker) -> void;
+
+	private:
+
+		std::vector<std::unique_ptr<_queue>> queues_{};
+
+		std::mutex mutex_{};
+		std::condition_variable wake_{};
+		std::condition_variable done_{};
+		_loop* loop_{ nullptr };
+		std::size_t generation_{ 0uz };
+		unsigned int active_{ 0u }; // threads which are inside loop_
+		bool stop_{ false };
+
+		std::vector<std::jthread> threads_{};
+
+	};
+
+
+	inline work_stealing_pool::work_stealing_pool(unsigned int threads)
+	{
+		if (threads == 0u)
+			threads = 1u; // hardware_concurrency might not know
+
+		queues_.reserve(threads);
+		for (auto i = 0u; i < threads; ++i)
+			queues_.push_back(std::make_unique<_queue>());
+
+		threads_.reserve(threads - 1u);
+		for (auto i = 1u; i < threads; ++i)
+			threads_.emplace_back([this, i] { _run(i); });
+	}
+
+	inline work_stealing_pool::~work_stealing_pool()
+	{
+		{
+			const auto lock = std::lock_guard{ mutex_ };
+			stop_ = true;
+		}
+		wake_.notify_all();
+		// jthreads join on destruction
+	}
+
+
+	inline auto work_stealing_pool::size() const noexcept -> unsigned int
+	{
+		return static_cast<unsigned int>(queues_.size());
+	}
+
+
+	template<typename F>
+	auto work_stealing_pool::parallel_for(std::size_t n, std::size_t grain, F&& f) -> void
+	{
+		if (grain == 0uz)
+			throw std::invalid_argument{ "Grain must be positive" };
+
+		if (n == 0uz)
+			return;
+
+		const auto ranges = (n + grain - 1uz) / grain;
+
+		auto loop = _loop{
+			[](void* f, std::size_t begin, std::size_t end) { (*static_cast<std::remove_reference_t<F>*>(f))(begin, end); },
+			const_cast<void*>(static_cast<const void*>(std::addressof(f))),
+			ranges
+		};
+
+		// each worker starts with a contiguous share, so neighbouring ranges tend to run on the same thread
+		const auto workers = queues_.size();
+		for (auto w = 0uz; w < workers; ++w)
+		{
+			const auto lock = std::lock_guard{ queues_[w]->mutex };
+			for (auto r = ranges * w / workers; r < ranges * (w + 1uz) / workers; ++r)
+				queues_[w]->ranges.emplace_back(r * grain, std::min(n, (r + 1uz) * grain));
+		}
+
+		{
+			const auto lock = std::lock_guard{ mutex_ };
+			loop_ = &loop;
+			++generation_;
+		}
+		wake_.notify_all();
+
+		_work(0u, loop);
+
+		{
+			// the others might still be finishing their last ranges, and loop must outlive them
+			auto lock = std::unique_lock{ mutex_ };
+			done_.wait(lock, [&] { return loop.remaining.load(std::memory_order_acquire) == 0uz; });
+			loop_ = nullptr;
+			done_.wait(lock, [&] { return active_ == 0u; });
+		}
+
+		if (loop.error)
+			std::rethrow_exception(loop.error);
+	}
+
+
+	inline auto work_stealing_pool::_work(unsigned int worker, _loop& loop) -> void
+	{
+		while (const auto range = _next(worker))
+		{
+			if (!loop.failed.load(std::memory_order_relaxed)) // after a failure the rest is only drained
+			{
+				try
+				{
+					loop.invoke(loop.f, range->first, range->second);
+				}
+				catch (...)
+				{
+					const auto lock = std::lock_guard{ loop.error_mutex };
+					if (!loop.error)
+						loop.error = std::current_exception();
+					loop.failed.store(true, std::memory_order_relaxed);
+				}
+			}
+
+			if (loop.remaining.fetch_sub(1uz, std::memory_order_acq_rel) == 1uz)
+			{
+				const auto lock = std::lock_guard{ mutex_ };
+				done_.notify_all();
+			}
+		}
+	}
+
+
+	inline auto work_stealing_pool::_next(unsigned int worker) -> std::optional<_range>
+	{
+		{
+			auto& own = *queues_[worker];
+			const auto lock = std::lock_guard{ own.mutex };
+			if (!own.ranges.empty())
+			{
+				const auto range = own.ranges.front();
+				own.ranges.pop_front();
+				return range;
+			}
+		}
+
+		// steal from the back, which is the work the owner would get to last
+		for (auto i = 1uz; i < queues_.size(); ++i)
+		{
+			auto& other = *queues_[(worker + i) % queues_.size()];
+			const auto lock = std::lock_guard{ other.mutex };
+			if (!other.ranges.empty())
+			{
+				const auto range = other.ranges.back();
+				other.ranges.pop_back();
+				return range;
+			}
+		}
+
+		return std::nullopt;
+	}
+
+
+	inline auto work_stealing_pool::_run(unsigned int worker) -> void
+	{
+		auto seen = 0uz;
+		for (;;)
+		{
+			_loop* loop = nullptr;
+			{
+				auto lock = std::unique_lock{ mutex_ };
+				wake_.wait(lock, [&] { return stop_ || (loop_ && generation_ != seen); });
+				if (stop_)
+					return;
+
+				seen = generation_;
+				loop = loop_;
+				++active_;
+			}
+
+			_work(worker, *loop);
+
+			{
+				const auto lock = std::lock_guard{ mutex_ };
+				--active_;
+			}
+			done_.notify_all();
+		}
+	}
+
+}
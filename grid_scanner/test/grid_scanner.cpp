@@ -0,0 +1,216 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <boost/multiprecision/cpp_dec_float.hpp>
+
+#include <grid_scanner.h>
+#include <work_stealing_pool.h>
+
+#include <ANBIMA.h>
+#include <bill.h>
+#include <bond.h>
+#include <quote.h>
+
+#include <resets_math.h>
+
+#include <calendar.h>
+#include <static_data.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+using namespace std;
+using namespace std::chrono;
+using namespace boost::multiprecision;
+using namespace gregorian;
+using namespace fin_calendar;
+using namespace reset;
+using namespace gregorian::static_data;
+
+
+namespace debt_security
+{
+
+	template<typename T>
+	static auto _LTN_grid() -> yield_grid<bill<T>, T>
+	{
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto face = T{ 1'000 };
+
+		auto bills = vector<bill<T>>{};
+		for (const auto maturity_date : { 2008y / July / 1d, 2010y / July / 1d, 2014y / March / 7d })
+			bills.emplace_back(issue_date, maturity_date, calendar, face);
+
+		auto yields = vector<T>{};
+		for (auto yield = 1'000; yield <= 1'500; yield += 7)
+			yields.push_back(from_percent(static_cast<T>(yield) / T{ 100 }));
+		yields.push_back(from_percent(T{ 1'436 } / T{ 100 }));
+
+		auto quotes = vector<quote<T>>{};
+		for (const auto settlement_date : { 2008y / May / 21d, 2008y / May / 22d })
+			quotes.emplace_back(settlement_date, face, 6u);
+
+		return yield_grid{ std::move(bills), std::move(yields), std::move(quotes) };
+	}
+
+
+	TEST(yield_grid, point1)
+	{
+		const auto grid = _LTN_grid<double>();
+
+		EXPECT_EQ(grid.size(), 3uz * 73uz * 2uz);
+		EXPECT_EQ(grid.point(0uz), (grid_point{ 0uz, 0uz, 0uz }));
+		EXPECT_EQ(grid.point(1uz), (grid_point{ 0uz, 0uz, 1uz }));
+		EXPECT_EQ(grid.point(2uz), (grid_point{ 0uz, 1uz, 0uz }));
+		EXPECT_EQ(grid.point(grid.size() - 1uz), (grid_point{ 2uz, 72uz, 1uz }));
+
+		for (auto i = 0uz; i < grid.size(); ++i)
+			EXPECT_EQ(grid.index(grid.point(i)), i);
+
+		EXPECT_THROW(grid.point(grid.size()), out_of_range);
+		EXPECT_THROW(grid.index(grid_point{ 3uz, 0uz, 0uz }), out_of_range);
+	}
+
+	TEST(yield_grid, price1)
+	{
+		const auto grid = _LTN_grid<double>();
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		EXPECT_EQ(grid.price(ANBIMA, grid.index(grid_point{ 1uz, 72uz, 0uz })), 753.315323);
+	}
+
+
+	// only prices one point at a time
+	struct _ANBIMA_from_scratch final
+	{
+		auto price(const double& yield, const bill<double>& bill, const debt_security::quote<double>& quote) const -> double
+		{
+			return debt_security::ANBIMA{}.price(yield, bill, quote);
+		}
+	};
+
+	TEST(grid_pricer, price1)
+	{
+		const auto grid = _LTN_grid<double>();
+		const auto ANBIMA = debt_security::ANBIMA{};
+		const auto from_scratch = _ANBIMA_from_scratch{};
+
+		static_assert(precomputing_methodology<debt_security::ANBIMA<double>, bill<double>, double>);
+		static_assert(!precomputing_methodology<_ANBIMA_from_scratch, bill<double>, double>);
+
+		auto pool = work_stealing_pool{ 3u };
+		const auto pricer = grid_pricer{ pool, grid, ANBIMA };
+		const auto pricer_from_scratch = grid_pricer{ pool, grid, from_scratch };
+
+		for (auto i = 0uz; i < grid.size(); ++i)
+		{
+			EXPECT_EQ(pricer(i), grid.price(ANBIMA, i));
+			EXPECT_EQ(pricer_from_scratch(i), grid.price(ANBIMA, i));
+		}
+	}
+
+
+	TEST(grid_scanner, scan_prices1)
+	{
+		const auto grid = _LTN_grid<double>();
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		auto expected = vector<double>{};
+		for (auto i = 0uz; i < grid.size(); ++i)
+			expected.push_back(grid.price(ANBIMA, i));
+
+		// the same table in the same order, however the work is spread
+		for (const auto threads : { 1u, 4u })
+			for (const auto grain : { 1uz, 5uz, 64uz })
+			{
+				auto pool = work_stealing_pool{ threads };
+				EXPECT_EQ(scan_prices(pool, grid, ANBIMA, table_reducer<double>{}, grain), expected);
+			}
+	}
+
+	TEST(grid_scanner, scan_prices2)
+	{
+		const auto grid = _LTN_grid<double>();
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		auto pool = work_stealing_pool{ 4u };
+
+		// prices fall with the yield and the time to maturity, so the highest is the shortest bill at the lowest yield and the later settlement
+		const auto max = scan_prices(pool, grid, ANBIMA, max_reducer<double>{}, 7uz);
+		ASSERT_TRUE(max.index);
+		EXPECT_EQ(grid.point(*max.index), (grid_point{ 0uz, 0uz, 1uz }));
+		EXPECT_EQ(max.value, grid.price(ANBIMA, 1uz));
+	}
+
+	TEST(grid_scanner, scan_price_differences1)
+	{
+		const auto grid_dec = _LTN_grid<cpp_dec_float_50>();
+		const auto grid_bin = _LTN_grid<double>();
+
+		const auto ANBIMA_dec = debt_security::ANBIMA<cpp_dec_float_50>{};
+		const auto ANBIMA_bin = debt_security::ANBIMA<double>{};
+
+		auto expected = max_reducer<double>{}.empty();
+		for (auto i = 0uz; i < grid_dec.size(); ++i)
+			max_reducer<double>{}.add(
+				expected,
+				i,
+				abs(static_cast<double>(grid_dec.price(ANBIMA_dec, i)) - grid_bin.price(ANBIMA_bin, i))
+			);
+
+		auto pool = work_stealing_pool{ 3u };
+
+		const auto max = scan_price_differences(pool, grid_dec, ANBIMA_dec, grid_bin, ANBIMA_bin, max_reducer<double>{}, 4uz);
+		EXPECT_EQ(max.index, expected.index);
+		EXPECT_EQ(max.value, expected.value);
+		EXPECT_LE(max.value, 1e-6); // at most one unit of the truncation
+	}
+
+	TEST(grid_scanner, scan1)
+	{
+		auto pool = work_stealing_pool{ 2u };
+
+		const auto empty = scan(pool, 0uz, [](size_t i) { return static_cast<double>(i); }, max_reducer<double>{});
+		EXPECT_FALSE(empty.index);
+
+		// ties keep the first point
+		const auto max = scan(pool, 100uz, [](size_t i) { return i < 10uz ? 0.0 : 1.0; }, max_reducer<double>{}, 3uz);
+		EXPECT_EQ(max.index, 10uz);
+	}
+
+	TEST(grid_scanner, scan2)
+	{
+		const auto values = vector<double>{ 0.1, 0.2, 0.3, 1e16, -1e16, 0.4, 0.5, 0.6, 0.7 };
+		const auto evaluate = [&](size_t i) { return values[i]; };
+
+		auto pool1 = work_stealing_pool{ 1u };
+		auto pool4 = work_stealing_pool{ 4u };
+
+		EXPECT_EQ(scan(pool1, values.size(), evaluate, sum_reducer<double>{}, 2uz), scan(pool4, values.size(), evaluate, sum_reducer<double>{}, 2uz));
+		EXPECT_EQ(scan(pool4, 101uz, [](size_t i) { return static_cast<int>(i); }, sum_reducer<int>{}, 8uz), 5'050);
+	}
+
+}
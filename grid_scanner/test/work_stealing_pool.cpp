@@ -0,0 +1,120 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <work_stealing_pool.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <stdexcept>
+
+using namespace std;
+
+
+namespace debt_security
+{
+
+	TEST(work_stealing_pool, constructor1)
+	{
+		EXPECT_EQ(work_stealing_pool{ 4u }.size(), 4u);
+		EXPECT_EQ(work_stealing_pool{ 0u }.size(), 1u);
+	}
+
+	TEST(work_stealing_pool, parallel_for1)
+	{
+		// every index exactly once, whatever the number of threads and the grain
+		for (const auto threads : { 1u, 2u, 7u })
+		{
+			auto pool = work_stealing_pool{ threads };
+			for (const auto grain : { 1uz, 3uz, 64uz, 5'000uz })
+			{
+				auto visits = vector<atomic<int>>(1'001uz);
+				pool.parallel_for(
+					visits.size(),
+					grain,
+					[&](size_t begin, size_t end)
+					{
+						EXPECT_LE(end - begin, grain);
+						for (auto i = begin; i < end; ++i)
+							++visits[i];
+					}
+				);
+
+				for (const auto& v : visits)
+					EXPECT_EQ(v.load(), 1);
+			}
+		}
+	}
+
+	TEST(work_stealing_pool, parallel_for2)
+	{
+		// uneven work: the first ranges are much slower, so the others have to be stolen to finish early
+		auto pool = work_stealing_pool{ 4u };
+
+		auto ids = vector<thread::id>(64uz);
+		pool.parallel_for(
+			ids.size(),
+			1uz,
+			[&](size_t begin, size_t)
+			{
+				if (begin < 4uz)
+					this_thread::sleep_for(50ms);
+				ids[begin] = this_thread::get_id();
+			}
+		);
+
+		for (const auto& id : ids)
+			EXPECT_NE(id, thread::id{});
+	}
+
+	TEST(work_stealing_pool, parallel_for3)
+	{
+		auto pool = work_stealing_pool{ 3u };
+
+		auto done = atomic<size_t>{ 0uz };
+		EXPECT_THROW(
+			pool.parallel_for(
+				100uz,
+				1uz,
+				[&](size_t begin, size_t)
+				{
+					if (begin == 42uz)
+						throw runtime_error{ "42" };
+					++done;
+				}
+			),
+			runtime_error
+		);
+		EXPECT_LT(done.load(), 100uz);
+
+		// the pool is still usable afterwards
+		auto sum = atomic<size_t>{ 0uz };
+		pool.parallel_for(100uz, 10uz, [&](size_t begin, size_t end) { for (auto i = begin; i < end; ++i) sum += i; });
+		EXPECT_EQ(sum.load(), 4'950uz);
+
+		EXPECT_THROW(pool.parallel_for(100uz, 0uz, [](size_t, size_t) {}), invalid_argument);
+		pool.parallel_for(0uz, 1uz, [](size_t, size_t) { FAIL(); });
+	}
+
+}
@@ -0,0 +1,181 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <utility>
+#include <optional>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace debt_security
+{
+
+	// value which is computed on the first request and then reused
+	// (safe to request from multiple threads, copies carry the value with them if it has been computed already)
+	// (guarded by a single byte of state rather than a mutex, as instruments carry several of these)
+	template<typename V>
+	class lazy final
+	{
+
+	public:
+
+		lazy() noexcept = default;
+
+		lazy(const lazy& other);
+		lazy(lazy&& other) noexcept(std::is_nothrow_move_constructible_v<V>);
+
+		auto operator=(const lazy& other) -> lazy&;
+		auto operator=(lazy&& other) noexcept(std::is_nothrow_move_constructible_v<V>) -> lazy&;
+
+	public:
+
+		template<typename F>
+		auto get(F&& make) const -> const V&;
+
+		auto has_value() const noexcept -> bool;
+
+	private:
+
+		enum class _state : std::uint8_t
+		{
+			empty,
+			computing, // by one thread, the others wait
+			ready
+		};
+
+	private:
+
+		mutable std::atomic<_state> state_{ _state::empty };
+		mutable std::optional<V> value_{};
+
+	};
+
+
+	template<typename V>
+	lazy<V>::lazy(const lazy& other)
+	{
+		if (other.has_value())
+		{
+			value_ = other.value_;
+			state_.store(_state::ready, std::memory_order_release);
+		}
+	}
+
+	// moving from a lazy takes no lock - nobody else should be using a value we own
+	template<typename V>
+	lazy<V>::lazy(lazy&& other) noexcept(std::is_nothrow_move_constructible_v<V>)
+	{
+		if (other.has_value())
+		{
+			value_.emplace(std::move(*other.value_));
+			state_.store(_state::ready, std::memory_order_release);
+
+			other.value_.reset();
+			other.state_.store(_state::empty, std::memory_order_release);
+		}
+	}
+
+	template<typename V>
+	auto lazy<V>::operator=(const lazy& other) -> lazy&
+	{
+		if (this != &other)
+		{
+			state_.store(_state::empty, std::memory_order_release);
+			value_.reset();
+
+			if (other.has_value())
+			{
+				value_ = other.value_;
+				state_.store(_state::ready, std::memory_order_release);
+			}
+		}
+
+		return *this;
+	}
+
+	template<typename V>
+	auto lazy<V>::operator=(lazy&& other) noexcept(std::is_nothrow_move_constructible_v<V>) -> lazy&
+	{
+		if (this != &other)
+		{
+			state_.store(_state::empty, std::memory_order_release);
+			value_.reset();
+
+			if (other.has_value())
+			{
+				value_.emplace(std::move(*other.value_));
+				state_.store(_state::ready, std::memory_order_release);
+
+				other.value_.reset();
+				other.state_.store(_state::empty, std::memory_order_release);
+			}
+		}
+
+		return *this;
+	}
+
+
+	template<typename V>
+	template<typename F>
+	auto lazy<V>::get(F&& make) const -> const V&
+	{
+		auto state = state_.load(std::memory_order_acquire);
+		while (state != _state::ready)
+		{
+			if (state == _state::computing)
+			{
+				state_.wait(_state::computing, std::memory_order_acquire);
+				state = state_.load(std::memory_order_acquire);
+			}
+			else if (state_.compare_exchange_weak(state, _state::computing, std::memory_order_acquire))
+			{
+				try
+				{
+					value_.emplace(std::forward<F>(make)());
+				}
+				catch (...)
+				{
+					// the next request tries again
+					state_.store(_state::empty, std::memory_order_release);
+					state_.notify_all();
+					throw;
+				}
+
+				state_.store(_state::ready, std::memory_order_release);
+				state_.notify_all();
+				state = _state::ready;
+			}
+		}
+
+		return *value_;
+	}
+
+	template<typename V>
+	auto lazy<V>::has_value() const noexcept -> bool
+	{
+		return state_.load(std::memory_order_acquire) == _state::ready;
+	}
+
+}
@@ -0,0 +1,134 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <lazy.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <stdexcept>
+
+using namespace std;
+
+
+namespace debt_security
+{
+
+	TEST(lazy, get1)
+	{
+		const auto l = lazy<string>{};
+		EXPECT_FALSE(l.has_value());
+
+		auto calls = 0;
+		const auto make = [&] { ++calls; return "abc"s; };
+
+		const auto& v1 = l.get(make);
+		const auto& v2 = l.get(make);
+
+		EXPECT_EQ(v1, "abc"s);
+		EXPECT_EQ(&v1, &v2);
+		EXPECT_EQ(calls, 1);
+		EXPECT_TRUE(l.has_value());
+	}
+
+	TEST(lazy, get2)
+	{
+		const auto l = lazy<int>{};
+
+		auto calls = atomic<int>{ 0 };
+		const auto make = [&] { ++calls; return 42; };
+
+		auto threads = vector<jthread>{};
+		for (auto i = 0; i < 8; ++i)
+			threads.emplace_back([&] { EXPECT_EQ(l.get(make), 42); });
+		threads.clear();
+
+		EXPECT_EQ(calls, 1);
+	}
+
+	TEST(lazy, copy1)
+	{
+		const auto l1 = lazy<int>{};
+		const auto l2 = l1;
+		EXPECT_FALSE(l2.has_value());
+
+		l1.get([] { return 1; });
+		const auto l3 = l1;
+		EXPECT_TRUE(l3.has_value());
+		EXPECT_EQ(l3.get([] { return 2; }), 1);
+	}
+
+	TEST(lazy, assign1)
+	{
+		auto l1 = lazy<int>{};
+		l1.get([] { return 1; });
+
+		auto l2 = lazy<int>{};
+		l2 = l1;
+		EXPECT_EQ(l2.get([] { return 2; }), 1);
+
+		l2 = lazy<int>{};
+		EXPECT_FALSE(l2.has_value());
+	}
+
+	TEST(lazy, get3)
+	{
+		const auto l = lazy<int>{};
+
+		// a failed computation is not cached
+		EXPECT_THROW(l.get([]() -> int { throw runtime_error{ "failed" }; }), runtime_error);
+		EXPECT_FALSE(l.has_value());
+		EXPECT_EQ(l.get([] { return 3; }), 3);
+	}
+
+	// counts its copies (and moves without throwing)
+	struct _copies final
+	{
+		_copies() = default;
+		_copies(const _copies& other) : copies{ other.copies + 1 } {}
+		_copies(_copies&& other) noexcept = default;
+
+		auto operator=(const _copies&) -> _copies& = delete;
+		auto operator=(_copies&&) noexcept -> _copies& = default;
+
+		int copies = 0;
+	};
+
+	TEST(lazy, move1)
+	{
+		static_assert(is_nothrow_move_constructible_v<lazy<vector<int>>>);
+		static_assert(is_nothrow_move_assignable_v<lazy<vector<int>>>);
+
+		// so growing a vector of them moves the values rather than copying them
+		auto ls = vector<lazy<_copies>>(1uz);
+		ls.front().get([] { return _copies{}; });
+		for (auto i = 0; i < 100; ++i)
+			ls.emplace_back();
+
+		EXPECT_TRUE(ls.front().has_value());
+		EXPECT_EQ(ls.front().get([] { return _copies{}; }).copies, 0);
+	}
+
+}
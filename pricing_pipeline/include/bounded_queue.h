@@ -0,0 +1,146 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <utility>
+#include <stdexcept>
+
+
+namespace debt_security
+{
+
+	// blocking queue which never holds more than its capacity, so a producer which is ahead waits for the consumers
+	// (once closed, push fails and pop returns what is left, then nothing)
+	template<typename V>
+	class bounded_queue final
+	{
+
+	public:
+
+		explicit bounded_queue(std::size_t capacity);
+
+		bounded_queue(const bounded_queue&) = delete;
+		bounded_queue(bounded_queue&&) = delete;
+
+		auto operator=(const bounded_queue&) -> bounded_queue& = delete;
+		auto operator=(bounded_queue&&) -> bounded_queue& = delete;
+
+	public:
+
+		auto push(V value) -> bool; // false if the queue is closed (and the value is dropped)
+		auto pop() -> std::optional<V>; // nothing once the queue is closed and empty
+
+		auto close() -> void;
+
+	public:
+
+		auto capacity() const noexcept -> std::size_t;
+
+	private:
+
+		std::mutex mutex_{};
+		std::condition_variable not_full_{};
+		std::condition_variable not_empty_{};
+
+		std::vector<std::optional<V>> slots_; // a ring, so nothing is allocated after construction
+		std::size_t head_{ 0uz };
+		std::size_t size_{ 0uz };
+		bool closed_{ false };
+
+	};
+
+
+	template<typename V>
+	bounded_queue<V>::bounded_queue(std::size_t capacity) :
+		slots_(capacity)
+	{
+		if (capacity == 0uz)
+			throw std::invalid_argument{ "Queue capacity must be positive" };
+	}
+
+
+	template<typename V>
+	auto bounded_queue<V>::push(V value) -> bool
+	{
+		{
+			auto lock = std::unique_lock{ mutex_ };
+			not_full_.wait(lock, [this] { return closed_ || size_ < slots_.size(); });
+
+			if (closed_)
+				return false;
+
+			slots_[(head_ + size_) % slots_.size()].emplace(std::move(value));
+			++size_;
+		}
+		not_empty_.notify_one();
+
+		return true;
+	}
+
+	template<typename V>
+	auto bounded_queue<V>::pop() -> std::optional<V>
+	{
+		auto result = std::optional<V>{};
+		{
+			auto lock = std::unique_lock{ mutex_ };
+			not_empty_.wait(lock, [this] { return closed_ || size_ > 0uz; });
+
+			if (size_ == 0uz)
+				return std::nullopt; // closed
+
+			auto& slot = slots_[head_];
+			result.emplace(std::move(*slot));
+			slot.reset();
+			head_ = (head_ + 1uz) % slots_.size();
+			--size_;
+		}
+		not_full_.notify_one();
+
+		return result;
+	}
+
+
+	template<typename V>
+	auto bounded_queue<V>::close() -> void
+	{
+		{
+			const auto lock = std::lock_guard{ mutex_ };
+			closed_ = true;
+		}
+		not_full_.notify_all();
+		not_empty_.notify_all();
+	}
+
+
+	template<typename V>
+	auto bounded_queue<V>::capacity() const noexcept -> std::size_t
+	{
+		return slots_.size();
+	}
+
+}
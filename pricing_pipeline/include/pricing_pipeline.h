@@ -0,0 +1,359 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <utility>
+#include <exception>
+#include <stdexcept>
+
+#include "bounded_queue.h"
+#include "quote_file.h"
+
+
+namespace debt_security
+{
+
+	struct pipeline_options final
+	{
+		unsigned int workers{ std::thread::hardware_concurrency() }; // threads which price (0 means 1)
+		std::size_t chunk_size{ 1uz << 20 }; // bytes read at a time (each row has to fit into a chunk)
+		std::size_t chunks{ 0uz }; // in flight at once, so memory use does not depend on the size of the file (0 means 2 per worker)
+		bool header{ false }; // the first line is copied across (with ",price" added) rather than priced
+	};
+
+	struct pipeline_statistics final
+	{
+		std::size_t rows{ 0uz };
+		std::size_t chunks{ 0uz };
+	};
+
+
+	// reads quote rows from in, prices them in parallel and writes each line with ",price" added to out, in the same order
+	// (price(const quote_row<T>&) -> T is called from several threads at once)
+	// throws what price throws, or std::runtime_error with the line number if a row cannot be parsed
+	template<typename T = double, typename Price>
+	auto price_quote_stream(
+		std::istream& in,
+		std::ostream& out,
+		Price&& price,
+		const pipeline_options& options = pipeline_options{}
+	) -> pipeline_statistics;
+
+
+	namespace _pricing_pipeline
+	{
+
+		// the unit of work: lines read in one go, and what they are priced to
+		// (chunks are reused, so once their buffers have grown nothing is allocated)
+		struct chunk final
+		{
+			std::size_t sequence{ 0uz };
+			std::size_t first_line{ 0uz }; // from 1, for error messages
+
+			std::vector<char> input{};
+			std::size_t input_size{ 0uz };
+
+			std::vector<char> output{};
+			std::size_t output_size{ 0uz };
+			std::size_t rows{ 0uz };
+		};
+
+		using chunk_ptr = std::unique_ptr<chunk>;
+
+
+		// the first exception stops everything
+		class failure final
+		{
+
+		public:
+
+			auto set(std::exception_ptr error) -> void
+			{
+				const auto lock = std::lock_guard{ mutex_ };
+				if (!error_)
+					error_ = std::move(error);
+			}
+
+			auto rethrow() -> void
+			{
+				const auto lock = std::lock_guard{ mutex_ };
+				if (error_)
+					std::rethrow_exception(error_);
+			}
+
+		private:
+
+			std::mutex mutex_{};
+			std::exception_ptr error_{};
+
+		};
+
+
+		// fills chunks from in, cut after the last complete line
+		// (the rest of the line is carried to the next chunk)
+		inline auto read(
+			std::istream& in,
+			std::size_t chunk_size,
+			bounded_queue<chunk_ptr>& free,
+			bounded_queue<chunk_ptr>& parsed
+		) -> std::size_t // chunks
+		{
+			auto carry = std::vector<char>{};
+			carry.reserve(chunk_size);
+
+			auto sequence = 0uz;
+			auto line = 1uz;
+			for (;;)
+			{
+				auto c = free.pop();
+				if (!c)
+					return sequence; // stopped
+
+				auto& input = (*c)->input;
+				input.resize(chunk_size);
+				std::ranges::copy(carry, input.begin());
+
+				in.read(input.data() + carry.size(), static_cast<std::streamsize>(chunk_size - carry.size()));
+				const auto size = carry.size() + static_cast<std::size_t>(in.gcount());
+				const auto end = in.eof();
+				if (!end && !in)
+					throw std::runtime_error{ "Cannot read quotes" };
+
+				if (size == 0uz)
+					return sequence;
+
+				auto cut = size; // at the end of the file a line does not need a new line
+				if (!end)
+				{
+					const auto last = std::ranges::find(input.rbegin() + static_cast<std::ptrdiff_t>(chunk_size - size), input.rend(), '\n');
+					if (last == input.rend())
+						throw std::runtime_error{ "Line " + std::to_string(line) + " is longer than a chunk" };
+
+					cut = static_cast<std::size_t>(input.rend() - last);
+				}
+
+				carry.assign(input.begin() + static_cast<std::ptrdiff_t>(cut), input.begin() + static_cast<std::ptrdiff_t>(size));
+
+				(*c)->sequence = sequence++;
+				(*c)->first_line = line;
+				(*c)->input_size = cut;
+				line += static_cast<std::size_t>(std::ranges::count(input.begin(), input.begin() + static_cast<std::ptrdiff_t>(cut), '\n'));
+
+				if (!parsed.push(std::move(*c)))
+					return sequence; // stopped
+
+				if (end)
+					return sequence;
+			}
+		}
+
+
+		template<typename T, typename Price>
+		auto price(chunk& c, bool header, Price& price_row) -> void
+		{
+			constexpr auto suffix = std::string_view{ ",price" };
+
+			c.output_size = 0uz;
+			c.rows = 0uz;
+
+			const auto reserve = [&](std::size_t size)
+			{
+				if (c.output.size() < c.output_size + size)
+					c.output.resize(std::max(c.output.size() * 2uz, c.output_size + size));
+			};
+
+			auto rest = std::string_view{ c.input.data(), c.input_size };
+			for (auto line = c.first_line; !rest.empty(); ++line)
+			{
+				const auto new_line = rest.find('\n');
+				auto text = rest.substr(0uz, new_line);
+				rest = new_line == std::string_view::npos ? std::string_view{} : rest.substr(new_line + 1uz);
+
+				if (!text.empty() && text.back() == '\r')
+					text.remove_suffix(1uz);
+
+				if (header && line == 1uz)
+				{
+					reserve(text.size() + suffix.size() + 1uz);
+					auto position = std::ranges::copy(text, c.output.data() + c.output_size).out;
+					position = std::ranges::copy(suffix, position).out;
+					*position++ = '\n';
+					c.output_size = static_cast<std::size_t>(position - c.output.data());
+					continue;
+				}
+
+				if (_quote_file::trim(text).empty())
+					continue; // blank lines are allowed (at the end of a file in particular)
+
+				const auto row = [&]
+				{
+					try
+					{
+						return parse_quote_row<T>(text);
+					}
+					catch (const std::invalid_argument& e)
+					{
+						throw std::runtime_error{ "Line " + std::to_string(line) + ": " + e.what() };
+					}
+				}();
+
+				const auto p = price_row(row);
+
+				reserve(text.size() + 1uz + max_price_chars + 1uz);
+				auto position = std::ranges::copy(text, c.output.data() + c.output_size).out;
+				*position++ = ',';
+				position = format_price(position, c.output.data() + c.output.size(), p);
+				*position++ = '\n';
+				c.output_size = static_cast<std::size_t>(position - c.output.data());
+
+				++c.rows;
+			}
+		}
+
+	}
+
+
+	template<typename T, typename Price>
+	auto price_quote_stream(
+		std::istream& in,
+		std::ostream& out,
+		Price&& price,
+		const pipeline_options& options
+	) -> pipeline_statistics
+	{
+		namespace pp = _pricing_pipeline;
+
+		if (options.chunk_size == 0uz)
+			throw std::invalid_argument{ "Chunk size must be positive" };
+
+		const auto workers = std::max(options.workers, 1u);
+		const auto chunks = options.chunks == 0uz ? 2uz * workers : options.chunks;
+
+		// the free chunks limit how far the reader can get ahead of the writer,
+		// so no queue is ever full and the writer only ever waits for the chunks which are in flight
+		auto free = bounded_queue<pp::chunk_ptr>{ chunks };
+		auto parsed = bounded_queue<pp::chunk_ptr>{ chunks };
+		auto priced = bounded_queue<pp::chunk_ptr>{ chunks };
+		for (auto i = 0uz; i < chunks; ++i)
+			free.push(std::make_unique<pp::chunk>());
+
+		auto failure = pp::failure{};
+		const auto stop = [&](std::exception_ptr error)
+		{
+			failure.set(std::move(error));
+			free.close();
+			parsed.close();
+			priced.close();
+		};
+
+		auto statistics = pipeline_statistics{};
+		auto remaining = std::atomic<unsigned int>{ workers };
+		{
+			auto threads = std::vector<std::jthread>{};
+			threads.reserve(workers + 1u);
+
+			threads.emplace_back([&]
+			{
+				try
+				{
+					statistics.chunks = pp::read(in, options.chunk_size, free, parsed);
+				}
+				catch (...)
+				{
+					stop(std::current_exception());
+				}
+				parsed.close();
+			});
+
+			for (auto w = 0u; w < workers; ++w)
+			{
+				threads.emplace_back([&]
+				{
+					try
+					{
+						while (auto c = parsed.pop())
+						{
+							pp::price<T>(**c, options.header, price);
+							if (!priced.push(std::move(*c)))
+								break;
+						}
+					}
+					catch (...)
+					{
+						stop(std::current_exception());
+					}
+
+					if (remaining.fetch_sub(1u) == 1u)
+						priced.close(); // the last one out
+				});
+			}
+
+			// chunks come out of order, but never more than we have, so a ring of them is enough to put them back in order
+			auto pending = std::vector<pp::chunk_ptr>(chunks);
+			auto next = 0uz;
+			try
+			{
+				while (auto c = priced.pop())
+				{
+					const auto sequence = (*c)->sequence;
+					pending[sequence % chunks] = std::move(*c);
+
+					for (auto* p = &pending[next % chunks]; *p && (*p)->sequence == next; p = &pending[next % chunks])
+					{
+						out.write((*p)->output.data(), static_cast<std::streamsize>((*p)->output_size));
+						if (!out)
+							throw std::runtime_error{ "Cannot write prices" };
+
+						statistics.rows += (*p)->rows;
+						++next;
+
+						free.push(std::move(*p));
+					}
+				}
+			}
+			catch (...)
+			{
+				stop(std::current_exception());
+			}
+			// jthreads join here
+		}
+
+		failure.rethrow();
+
+		out.flush();
+
+		return statistics;
+	}
+
+}
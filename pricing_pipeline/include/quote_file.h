@@ -0,0 +1,198 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <chrono>
+#include <concepts>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <algorithm>
+#include <system_error>
+#include <stdexcept>
+
+
+namespace debt_security
+{
+
+	// a row of a quote file: instrument,settlement date,yield (for example "LTN 2010-07-01,2008-05-21,14.36")
+	// (the instrument refers into the line it was parsed from)
+	template<typename T = double>
+	struct quote_row final
+	{
+		std::string_view instrument;
+		std::chrono::year_month_day settlement_date; // as YYYY-MM-DD
+		T yield; // as in the file (so usually a percentage)
+	};
+
+
+	// throws std::invalid_argument if the line is not a row
+	// (nothing is allocated for binary floating point yields)
+	template<typename T = double>
+	auto parse_quote_row(std::string_view line) -> quote_row<T>;
+
+
+	// enough for any price format_price writes for double, or for decimals of up to 50 digits
+	inline constexpr auto max_price_chars = 64uz;
+
+	// writes the price into [first, last) and returns where it ended
+	// (the shortest text which reads back as the same binary floating point price, or all the digits of a decimal one)
+	template<typename T = double>
+	auto format_price(char* first, char* last, const T& price) -> char*;
+
+
+	namespace _quote_file
+	{
+
+		inline auto trim(std::string_view s) noexcept -> std::string_view
+		{
+			const auto space = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+
+			while (!s.empty() && space(s.front()))
+				s.remove_prefix(1uz);
+			while (!s.empty() && space(s.back()))
+				s.remove_suffix(1uz);
+
+			return s;
+		}
+
+		// the next comma separated field (and the rest of the line after it)
+		inline auto next_field(std::string_view& line) noexcept -> std::string_view
+		{
+			const auto comma = line.find(',');
+			const auto field = line.substr(0uz, comma);
+			line = comma == std::string_view::npos ? std::string_view{} : line.substr(comma + 1uz);
+
+			return trim(field);
+		}
+
+		template<typename I>
+		auto parse_integer(const char*& first, const char* last, std::size_t digits) -> I
+		{
+			auto value = I{};
+			const auto [end, error] = std::from_chars(first, last, value);
+			if (error != std::errc{} || static_cast<std::size_t>(end - first) != digits)
+				throw std::invalid_argument{ "Date is not YYYY-MM-DD" };
+
+			first = end;
+			return value;
+		}
+
+		inline auto parse_date(std::string_view field) -> std::chrono::year_month_day
+		{
+			auto first = field.data();
+			const auto last = field.data() + field.size();
+
+			const auto separator = [&]
+			{
+				if (first == last || *first != '-')
+					throw std::invalid_argument{ "Date is not YYYY-MM-DD" };
+				++first;
+			};
+
+			const auto y = parse_integer<int>(first, last, 4uz);
+			separator();
+			const auto m = parse_integer<unsigned int>(first, last, 2uz);
+			separator();
+			const auto d = parse_integer<unsigned int>(first, last, 2uz);
+			if (first != last)
+				throw std::invalid_argument{ "Date is not YYYY-MM-DD" };
+
+			const auto date = std::chrono::year{ y } / std::chrono::month{ m } / std::chrono::day{ d };
+			if (!date.ok())
+				throw std::invalid_argument{ "Date does not exist" };
+
+			return date;
+		}
+
+		template<typename T>
+		auto parse_number(std::string_view field) -> T
+		{
+			if constexpr (std::floating_point<T>)
+			{
+				auto value = T{};
+				const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+				if (error != std::errc{} || end != field.data() + field.size())
+					throw std::invalid_argument{ "Yield is not a number" };
+
+				return value;
+			}
+			else
+			{
+				// decimals do not have from_chars, so we go through a stream
+				auto s = std::istringstream{ std::string{ field } };
+				auto value = T{};
+				if (!(s >> value) || !(s >> std::ws).eof())
+					throw std::invalid_argument{ "Yield is not a number" };
+
+				return value;
+			}
+		}
+
+	}
+
+
+	template<typename T>
+	auto parse_quote_row(std::string_view line) -> quote_row<T>
+	{
+		const auto instrument = _quote_file::next_field(line);
+		if (instrument.empty())
+			throw std::invalid_argument{ "Row has no instrument" };
+
+		const auto settlement_date = _quote_file::parse_date(_quote_file::next_field(line));
+		const auto yield = _quote_file::parse_number<T>(_quote_file::next_field(line));
+		if (!line.empty())
+			throw std::invalid_argument{ "Row has more than 3 fields" };
+
+		return quote_row<T>{ instrument, settlement_date, yield };
+	}
+
+
+	template<typename T>
+	auto format_price(char* first, char* last, const T& price) -> char*
+	{
+		if constexpr (std::floating_point<T>)
+		{
+			const auto [end, error] = std::to_chars(first, last, price);
+			if (error != std::errc{})
+				throw std::length_error{ "No room to format a price" };
+
+			return end;
+		}
+		else
+		{
+			auto s = std::ostringstream{};
+			s << std::setprecision(std::numeric_limits<T>::digits10) << price;
+			const auto text = std::move(s).str();
+			if (text.size() > static_cast<std::size_t>(last - first))
+				throw std::length_error{ "No room to format a price" };
+
+			return std::ranges::copy(text, first).out;
+		}
+	}
+
+}
@@ -0,0 +1,95 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <bounded_queue.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+#include <numeric>
+#include <stdexcept>
+
+using namespace std;
+
+
+namespace debt_security
+{
+
+	TEST(bounded_queue, constructor1)
+	{
+		EXPECT_EQ(bounded_queue<int>{ 3uz }.capacity(), 3uz);
+		EXPECT_THROW(bounded_queue<int>{ 0uz }, invalid_argument);
+	}
+
+	TEST(bounded_queue, push1)
+	{
+		auto q = bounded_queue<int>{ 2uz };
+
+		EXPECT_TRUE(q.push(1));
+		EXPECT_TRUE(q.push(2));
+		EXPECT_EQ(q.pop(), 1);
+		EXPECT_TRUE(q.push(3)); // around the ring
+		EXPECT_EQ(q.pop(), 2);
+		EXPECT_EQ(q.pop(), 3);
+	}
+
+	TEST(bounded_queue, close1)
+	{
+		auto q = bounded_queue<int>{ 2uz };
+
+		q.push(1);
+		q.close();
+
+		EXPECT_FALSE(q.push(2));
+		EXPECT_EQ(q.pop(), 1); // what is left
+		EXPECT_EQ(q.pop(), nullopt);
+	}
+
+	TEST(bounded_queue, threads1)
+	{
+		// far more values than the queue holds, so the producers have to wait for the consumers
+		constexpr auto producers = 3;
+		constexpr auto consumers = 3;
+		constexpr auto values = 10'000;
+
+		auto q = bounded_queue<int>{ 4uz };
+
+		auto sums = vector<long long>(consumers);
+		{
+			auto threads = vector<jthread>{};
+			for (auto c = 0; c < consumers; ++c)
+				threads.emplace_back([&, c] { while (const auto v = q.pop()) sums[c] += *v; });
+
+			{
+				auto writers = vector<jthread>{};
+				for (auto p = 0; p < producers; ++p)
+					writers.emplace_back([&] { for (auto v = 1; v <= values; ++v) q.push(v); });
+			}
+
+			q.close();
+		}
+
+		EXPECT_EQ(accumulate(sums.begin(), sums.end(), 0LL), producers * (values * (values + 1LL) / 2LL));
+	}
+
+}
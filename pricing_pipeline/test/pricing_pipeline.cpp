@@ -0,0 +1,177 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <pricing_pipeline.h>
+#include <quote_file.h>
+
+#include <ANBIMA.h>
+#include <bill.h>
+#include <quote.h>
+
+#include <resets_math.h>
+
+#include <static_data.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <sstream>
+#include <map>
+#include <stdexcept>
+
+using namespace std;
+using namespace std::chrono;
+using namespace gregorian::static_data;
+using namespace reset;
+
+
+namespace debt_security
+{
+
+	static auto _price_row(const quote_row<double>& row) -> double
+	{
+		return stod(string{ row.instrument }) + row.yield;
+	}
+
+
+	TEST(pricing_pipeline, price_quote_stream1)
+	{
+		constexpr auto rows = 5'000;
+
+		auto in = stringstream{};
+		auto expected = string{};
+		for (auto i = 0; i < rows; ++i)
+		{
+			const auto line = to_string(i) + ",2008-05-21," + to_string(i % 7) + ".5";
+			in << line << '\n';
+			expected += line + ',' + to_string(i + i % 7) + ".5\n";
+		}
+
+		// chunks much smaller than the file, so rows are split across chunks, and chunks are priced out of order
+		const auto options = pipeline_options{ .workers = 4u, .chunk_size = 64uz, .chunks = 3uz };
+
+		auto out = stringstream{};
+		const auto statistics = price_quote_stream(in, out, _price_row, options);
+
+		EXPECT_EQ(out.str(), expected);
+		EXPECT_EQ(statistics.rows, static_cast<size_t>(rows));
+		EXPECT_GT(statistics.chunks, 100uz);
+	}
+
+	TEST(pricing_pipeline, price_quote_stream2)
+	{
+		// a header, Windows line ends, a blank line and no new line at the end
+		auto in = stringstream{ "instrument,settlement,yield\r\n1,2008-05-21,1.5\r\n\r\n2,2008-05-21,2.25"s };
+
+		auto out = stringstream{};
+		const auto statistics = price_quote_stream(in, out, _price_row, pipeline_options{ .workers = 2u, .header = true });
+
+		EXPECT_EQ(out.str(), "instrument,settlement,yield,price\n1,2008-05-21,1.5,2.5\n2,2008-05-21,2.25,4.25\n"s);
+		EXPECT_EQ(statistics.rows, 2uz);
+	}
+
+	TEST(pricing_pipeline, price_quote_stream3)
+	{
+		auto in = stringstream{};
+		auto out = stringstream{};
+		const auto statistics = price_quote_stream(in, out, _price_row);
+
+		EXPECT_TRUE(out.str().empty());
+		EXPECT_EQ(statistics.rows, 0uz);
+	}
+
+	TEST(pricing_pipeline, price_quote_stream4)
+	{
+		auto in = stringstream{ "1,2008-05-21,1.5\n2,2008-05-21,2.5\n3,2008-05-32,3.5\n4,2008-05-21,4.5\n"s };
+		auto out = stringstream{};
+
+		try
+		{
+			price_quote_stream(in, out, _price_row, pipeline_options{ .workers = 2u, .chunk_size = 20uz });
+			FAIL();
+		}
+		catch (const runtime_error& e)
+		{
+			EXPECT_TRUE(string_view{ e.what() }.starts_with("Line 3: "sv));
+		}
+	}
+
+	TEST(pricing_pipeline, price_quote_stream5)
+	{
+		auto in = stringstream{ "1,2008-05-21,1.5\n12345678901234567890,2008-05-21,2.5\n"s };
+		auto out = stringstream{};
+
+		EXPECT_THROW(price_quote_stream(in, out, _price_row, pipeline_options{ .chunk_size = 20uz }), runtime_error);
+		EXPECT_THROW(price_quote_stream(in, out, _price_row, pipeline_options{ .chunk_size = 0uz }), invalid_argument);
+	}
+
+	TEST(pricing_pipeline, price_quote_stream6)
+	{
+		auto in = stringstream{ "1,2008-05-21,1.5\n2,2008-05-21,2.5\n"s };
+		auto out = stringstream{};
+
+		const auto fail = [](const quote_row<double>& row) -> double
+		{
+			if (row.instrument == "2"sv)
+				throw domain_error{ "No price" };
+
+			return row.yield;
+		};
+
+		EXPECT_THROW(price_quote_stream(in, out, fail), domain_error);
+	}
+
+	TEST(pricing_pipeline, price_quote_stream7)
+	{
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto bills = map<string, bill<double>, less<>>{
+			{ "LTN 2010-07-01"s, bill{ 2007y / July / 1d, 2010y / July / 1d, calendar, face } },
+			{ "LTN 2012-01-01"s, bill{ 2007y / July / 1d, 2012y / January / 1d, calendar, face } }
+		};
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto price = [&](const quote_row<double>& row)
+		{
+			const auto q = quote{ row.settlement_date, face, 6u };
+			return ANBIMA.price(from_percent(row.yield), bills.find(row.instrument)->second, q);
+		};
+
+		auto in = stringstream{ "LTN 2010-07-01,2008-05-21,14.36\nLTN 2012-01-01,2008-05-21,14.5\n"s };
+		auto out = stringstream{};
+		price_quote_stream(in, out, price);
+
+		const auto q = quote{ 2008y / May / 21d, face, 6u };
+		const auto p1 = ANBIMA.price(from_percent(14.36), bills.at("LTN 2010-07-01"s), q);
+		const auto p2 = ANBIMA.price(from_percent(14.5), bills.at("LTN 2012-01-01"s), q);
+
+		EXPECT_EQ(p1, 753.315323);
+
+		auto buffer = array<char, max_price_chars>{};
+		const auto text2 = string{ buffer.data(), format_price(buffer.data(), buffer.data() + buffer.size(), p2) };
+		EXPECT_EQ(out.str(), "LTN 2010-07-01,2008-05-21,14.36,753.315323\nLTN 2012-01-01,2008-05-21,14.5,"s + text2 + '\n');
+	}
+
+}
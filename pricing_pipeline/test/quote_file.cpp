@@ -0,0 +1,103 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <boost/multiprecision/cpp_dec_float.hpp>
+
+#include <quote_file.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+
+using namespace std;
+using namespace std::chrono;
+using namespace boost::multiprecision;
+
+
+namespace debt_security
+{
+
+	TEST(quote_file, parse_quote_row1)
+	{
+		const auto row = parse_quote_row("LTN 2010-07-01,2008-05-21,14.36"sv);
+
+		EXPECT_EQ(row.instrument, "LTN 2010-07-01"sv);
+		EXPECT_EQ(row.settlement_date, 2008y / May / 21d);
+		EXPECT_EQ(row.yield, 14.36);
+	}
+
+	TEST(quote_file, parse_quote_row2)
+	{
+		// spaces around fields (and a carriage return) are ignored
+		const auto row = parse_quote_row(" 7 , 2008-05-21 , 13.66\r"sv);
+
+		EXPECT_EQ(row.instrument, "7"sv);
+		EXPECT_EQ(row.settlement_date, 2008y / May / 21d);
+		EXPECT_EQ(row.yield, 13.66);
+	}
+
+	TEST(quote_file, parse_quote_row3)
+	{
+		const auto row = parse_quote_row<cpp_dec_float_50>("NTN-F,2008-05-21,13.66"sv);
+
+		EXPECT_EQ(row.yield, cpp_dec_float_50{ "13.66" }); // exactly
+	}
+
+	TEST(quote_file, parse_quote_row4)
+	{
+		EXPECT_THROW(parse_quote_row(""sv), invalid_argument);
+		EXPECT_THROW(parse_quote_row(",2008-05-21,13.66"sv), invalid_argument);
+		EXPECT_THROW(parse_quote_row("LTN,2008-5-21,13.66"sv), invalid_argument);
+		EXPECT_THROW(parse_quote_row("LTN,2008-02-30,13.66"sv), invalid_argument);
+		EXPECT_THROW(parse_quote_row("LTN,21/05/2008,13.66"sv), invalid_argument);
+		EXPECT_THROW(parse_quote_row("LTN,2008-05-21"sv), invalid_argument);
+		EXPECT_THROW(parse_quote_row("LTN,2008-05-21,13.66%"sv), invalid_argument);
+		EXPECT_THROW(parse_quote_row("LTN,2008-05-21,13.66,1"sv), invalid_argument);
+		EXPECT_THROW(parse_quote_row<cpp_dec_float_50>("LTN,2008-05-21,x"sv), invalid_argument);
+	}
+
+	TEST(quote_file, format_price1)
+	{
+		auto buffer = array<char, max_price_chars>{};
+
+		const auto end = format_price(buffer.data(), buffer.data() + buffer.size(), 903.075616);
+		EXPECT_EQ(string_view(buffer.data(), end), "903.075616"sv);
+
+		EXPECT_THROW(format_price(buffer.data(), buffer.data() + 3, 903.075616), length_error);
+	}
+
+	TEST(quote_file, format_price2)
+	{
+		auto buffer = array<char, max_price_chars>{};
+
+		const auto end = format_price(buffer.data(), buffer.data() + buffer.size(), cpp_dec_float_50{ "753.315323" });
+		EXPECT_EQ(string_view(buffer.data(), end), "753.315323"sv);
+
+		const auto third = cpp_dec_float_50{ 1 } / 3;
+		const auto end3 = format_price(buffer.data(), buffer.data() + buffer.size(), third);
+		EXPECT_EQ(cpp_dec_float_50{ string(buffer.data(), end3) }, cpp_dec_float_50{ "0.33333333333333333333333333333333333333333333333333" });
+	}
+
+}
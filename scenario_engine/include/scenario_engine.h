@@ -0,0 +1,315 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <span>
+#include <utility>
+#include <stdexcept>
+
+#include <bill.h>
+#include <bond.h>
+#include <quote.h>
+#include <ANBIMA.h>
+#include <grid_scanner.h>
+#include <work_stealing_pool.h>
+
+
+namespace debt_security
+{
+
+	// yield shifts (as yields, so 0.0001 is a basis point), one row per scenario and one column per position of a portfolio
+	template<typename T = double>
+	class yield_shocks final
+	{
+
+	public:
+
+		explicit yield_shocks(std::size_t positions);
+
+	public:
+
+		auto add(std::span<const T> shocks) -> void;
+
+		auto add_parallel(const T& shift) -> void;
+
+		// linear from the first position to the last one (so positions are expected in order of maturity)
+		auto add_twist(const T& first, const T& last) -> void;
+
+	public:
+
+		auto scenarios() const noexcept -> std::size_t;
+		auto positions() const noexcept -> std::size_t;
+
+		auto operator()(std::size_t scenario, std::size_t position) const -> const T&;
+
+	private:
+
+		std::size_t positions_;
+
+		std::vector<T> shocks_; // by scenario, then position
+
+	};
+
+
+	template<typename T>
+	struct scenario_results final
+	{
+		std::vector<T> pnl; // by scenario
+		std::vector<T> position_pnl; // by scenario, then position
+	};
+
+
+	// P&L of a portfolio of bills and bonds under each of the scenarios of yield shocks, against the prices at the base yields
+	// (the flows of a position and their year fractions are worked out once, when it is added, and reused by all scenarios)
+	template<typename T = double>
+	class scenario_engine final
+	{
+
+	public:
+
+		explicit scenario_engine(const quote<T>& quote);
+
+	public:
+
+		// notional is in the units of the face of the quote, and the result is the index of the position
+		auto add(const bill<T>& bill, const T& notional, const T& yield) -> std::size_t;
+		auto add(const bond<T>& bond, const T& notional, const T& yield) -> std::size_t;
+
+	public:
+
+		auto size() const noexcept -> std::size_t;
+
+		auto get_quote() const noexcept -> const quote<T>&;
+
+		// the value of the portfolio at the base yields
+		auto value() const -> T;
+
+		// (scenario x position) points are spread over the pool in ranges of grain points, and P&L is added up
+		// by scenario in the order of the positions, so the results do not depend on the grain or on the number of threads
+		auto run(
+			work_stealing_pool& pool,
+			const yield_shocks<T>& shocks,
+			std::size_t grain
+		) const -> scenario_results<T>;
+
+	private:
+
+		template<typename Instrument>
+		auto _add(const Instrument& instrument, const T& notional, const T& yield) -> std::size_t;
+
+		auto _value(std::size_t position, const T& price) const -> T;
+
+	private:
+
+		struct _position final
+		{
+			typename ANBIMA<T>::discounted_flows flows;
+			T notional;
+			T yield;
+			T price; // at the base yield
+		};
+
+	private:
+
+		ANBIMA<T> methodology_;
+
+		quote<T> quote_;
+
+		std::vector<_position> positions_;
+
+	};
+
+
+
+	template<typename T>
+	yield_shocks<T>::yield_shocks(std::size_t positions) :
+		positions_{ positions },
+		shocks_{}
+	{
+	}
+
+
+	template<typename T>
+	auto yield_shocks<T>::add(std::span<const T> shocks) -> void
+	{
+		if (shocks.size() != positions_)
+			throw std::invalid_argument{ "A scenario must have a shock for each position" };
+
+		shocks_.insert(shocks_.end(), shocks.begin(), shocks.end());
+	}
+
+
+	template<typename T>
+	auto yield_shocks<T>::add_parallel(const T& shift) -> void
+	{
+		shocks_.insert(shocks_.end(), positions_, shift);
+	}
+
+
+	template<typename T>
+	auto yield_shocks<T>::add_twist(const T& first, const T& last) -> void
+	{
+		if (positions_ == 1uz)
+		{
+			shocks_.push_back(first);
+			return;
+		}
+
+		const auto steps = static_cast<T>(positions_ - 1uz);
+		for (auto i = 0uz; i < positions_; ++i)
+			shocks_.push_back(T{ first + (last - first) * static_cast<T>(i) / steps });
+	}
+
+
+	template<typename T>
+	auto yield_shocks<T>::scenarios() const noexcept -> std::size_t
+	{
+		return positions_ == 0uz ? 0uz : shocks_.size() / positions_; // a portfolio without positions has no scenarios to speak of
+	}
+
+
+	template<typename T>
+	auto yield_shocks<T>::positions() const noexcept -> std::size_t
+	{
+		return positions_;
+	}
+
+
+	template<typename T>
+	auto yield_shocks<T>::operator()(std::size_t scenario, std::size_t position) const -> const T&
+	{
+		return shocks_[scenario * positions_ + position];
+	}
+
+
+
+	template<typename T>
+	scenario_engine<T>::scenario_engine(const quote<T>& quote) :
+		methodology_{},
+		quote_{ quote },
+		positions_{}
+	{
+	}
+
+
+	template<typename T>
+	auto scenario_engine<T>::add(const bill<T>& bill, const T& notional, const T& yield) -> std::size_t
+	{
+		return _add(bill, notional, yield);
+	}
+
+
+	template<typename T>
+	auto scenario_engine<T>::add(const bond<T>& bond, const T& notional, const T& yield) -> std::size_t
+	{
+		return _add(bond, notional, yield);
+	}
+
+
+	template<typename T>
+	auto scenario_engine<T>::size() const noexcept -> std::size_t
+	{
+		return positions_.size();
+	}
+
+
+	template<typename T>
+	auto scenario_engine<T>::get_quote() const noexcept -> const quote<T>&
+	{
+		return quote_;
+	}
+
+
+	template<typename T>
+	auto scenario_engine<T>::value() const -> T
+	{
+		auto value = T{ 0 };
+		for (auto i = 0uz; i < positions_.size(); ++i)
+			value += _value(i, positions_[i].price);
+
+		return value;
+	}
+
+
+	template<typename T>
+	auto scenario_engine<T>::run(
+		work_stealing_pool& pool,
+		const yield_shocks<T>& shocks,
+		std::size_t grain
+	) const -> scenario_results<T>
+	{
+		if (shocks.positions() != positions_.size())
+			throw std::invalid_argument{ "Shocks must have a column for each position" };
+
+		const auto positions = positions_.size();
+		const auto scenarios = shocks.scenarios();
+
+		auto position_pnl = scan(
+			pool,
+			scenarios * positions,
+			[&](std::size_t i)
+			{
+				const auto scenario = i / positions;
+				const auto position = i % positions;
+				const auto& p = positions_[position];
+
+				const auto price = methodology_.price(T{ p.yield + shocks(scenario, position) }, p.flows, quote_);
+
+				return T{ _value(position, price) - _value(position, p.price) };
+			},
+			table_reducer<T>{},
+			grain
+		);
+
+		// totals are always added up in the same order, however the points were spread over the threads
+		auto pnl = std::vector<T>(scenarios, T{ 0 });
+		for (auto s = 0uz; s < scenarios; ++s)
+			for (auto i = 0uz; i < positions; ++i)
+				pnl[s] += position_pnl[s * positions + i];
+
+		return scenario_results<T>{ std::move(pnl), std::move(position_pnl) };
+	}
+
+
+	template<typename T>
+	template<typename Instrument>
+	auto scenario_engine<T>::_add(const Instrument& instrument, const T& notional, const T& yield) -> std::size_t
+	{
+		auto flows = methodology_.precompute_flows(instrument, quote_);
+		const auto price = methodology_.price(yield, flows, quote_);
+
+		positions_.emplace_back(std::move(flows), notional, yield, price);
+
+		return positions_.size() - 1uz;
+	}
+
+
+	template<typename T>
+	auto scenario_engine<T>::_value(std::size_t position, const T& price) const -> T
+	{
+		return T{ positions_[position].notional * price / quote_.get_face() };
+	}
+
+}
@@ -0,0 +1,197 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <boost/multiprecision/cpp_dec_float.hpp>
+
+#include <scenario_engine.h>
+#include <work_stealing_pool.h>
+
+#include <ANBIMA.h>
+#include <bill.h>
+#include <bond.h>
+#include <quote.h>
+
+#include <resets_math.h>
+
+#include <calendar.h>
+#include <static_data.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+using namespace std;
+using namespace std::chrono;
+using namespace boost::multiprecision;
+using namespace gregorian;
+using namespace fin_calendar;
+using namespace reset;
+using namespace gregorian::static_data;
+
+
+namespace debt_security
+{
+
+	template<typename T>
+	static auto _LTN(const year_month_day& maturity_date) -> bill<T>
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = T{ 1'000 };
+
+		return bill{ issue_date, maturity_date, calendar, face };
+	}
+
+	template<typename T>
+	static auto _NTN_F(const year_month_day& maturity_date) -> bond<T>
+	{
+		const auto issue_date = 2008y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = T{ 10 };
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = T{ 1'000 };
+		const auto round_flows = 5u;
+
+		return bond{ issue_date, maturity_date, frequency, coupon, calendar, face, round_flows };
+	}
+
+
+	TEST(yield_shocks, add1)
+	{
+		auto shocks = yield_shocks{ 3uz };
+		EXPECT_EQ(shocks.positions(), 3uz);
+		EXPECT_EQ(shocks.scenarios(), 0uz);
+
+		shocks.add_parallel(0.0001);
+		shocks.add_twist(-0.0010, 0.0010);
+		const auto custom = vector{ 0.0003, 0.0002, 0.0001 };
+		shocks.add(custom);
+		EXPECT_EQ(shocks.scenarios(), 3uz);
+
+		EXPECT_EQ(shocks(0uz, 0uz), 0.0001);
+		EXPECT_EQ(shocks(0uz, 2uz), 0.0001);
+		EXPECT_EQ(shocks(1uz, 0uz), -0.0010);
+		EXPECT_EQ(shocks(1uz, 1uz), 0.0);
+		EXPECT_EQ(shocks(1uz, 2uz), 0.0010);
+		EXPECT_EQ(shocks(2uz, 1uz), 0.0002);
+
+		const auto short_one = vector{ 0.0001, 0.0002 };
+		EXPECT_THROW(shocks.add(short_one), invalid_argument);
+	}
+
+	TEST(scenario_engine, run1)
+	{
+		const auto LTN = _LTN<double>(2010y / July / 1d);
+		const auto NTN_F = _NTN_F<double>(2014y / January / 1d);
+
+		const auto quote = debt_security::quote{ 2008y / May / 21d, 1'000.0, 6u };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		auto engine = scenario_engine{ quote };
+		EXPECT_EQ(engine.add(LTN, 2'000'000.0, from_percent(14.36)), 0uz);
+		EXPECT_EQ(engine.add(NTN_F, 500'000.0, from_percent(13.66)), 1uz);
+		EXPECT_EQ(engine.size(), 2uz);
+
+		EXPECT_DOUBLE_EQ(engine.value(), 2'000.0 * 753.315323 + 500.0 * 903.075616);
+
+		auto shocks = yield_shocks{ 2uz };
+		shocks.add_parallel(0.0);
+		shocks.add_parallel(0.0001);
+		shocks.add_twist(-0.0050, 0.0050);
+
+		auto pool = work_stealing_pool{ 2u };
+		const auto r = engine.run(pool, shocks, 1uz);
+		ASSERT_EQ(r.pnl.size(), 3uz);
+		ASSERT_EQ(r.position_pnl.size(), 6uz);
+
+		EXPECT_EQ(r.pnl[0], 0.0);
+
+		// the same as repricing from scratch
+		for (auto s = 1uz; s < 3uz; ++s)
+		{
+			const auto ltn = 2'000.0 * (ANBIMA.price(from_percent(14.36) + shocks(s, 0uz), LTN, quote) - 753.315323);
+			const auto ntn_f = 500.0 * (ANBIMA.price(from_percent(13.66) + shocks(s, 1uz), NTN_F, quote) - 903.075616);
+			EXPECT_NEAR(r.position_pnl[s * 2uz], ltn, 1e-6);
+			EXPECT_NEAR(r.position_pnl[s * 2uz + 1uz], ntn_f, 1e-6);
+			EXPECT_EQ(r.pnl[s], r.position_pnl[s * 2uz] + r.position_pnl[s * 2uz + 1uz]);
+		}
+
+		EXPECT_LT(r.pnl[1], 0.0); // higher yields, lower prices
+		EXPECT_LT(r.position_pnl[5], 0.0); // the long end goes up in the twist
+		EXPECT_GT(r.position_pnl[4], 0.0);
+	}
+
+	TEST(scenario_engine, run2)
+	{
+		const auto quote = debt_security::quote{ 2008y / May / 21d, 1'000.0, 6u };
+
+		auto engine = scenario_engine{ quote };
+		for (const auto maturity_date : { 2008y / July / 1d, 2009y / January / 1d, 2010y / July / 1d, 2012y / January / 1d })
+			engine.add(_LTN<double>(maturity_date), 1'234'567.0, from_percent(12.5));
+		for (const auto maturity_date : { 2010y / January / 1d, 2012y / January / 1d, 2014y / January / 1d, 2017y / January / 1d })
+			engine.add(_NTN_F<double>(maturity_date), 7'654'321.0, from_percent(13.1));
+
+		auto shocks = yield_shocks{ engine.size() };
+		for (auto bp = -100; bp <= 100; bp += 5)
+		{
+			shocks.add_parallel(bp / 10'000.0);
+			shocks.add_twist(bp / 10'000.0, -bp / 20'000.0);
+		}
+
+		auto pool1 = work_stealing_pool{ 1u };
+		const auto r1 = engine.run(pool1, shocks, 1uz);
+
+		// the same bits whatever the threads and the grain
+		auto pool4 = work_stealing_pool{ 4u };
+		for (const auto grain : { 1uz, 3uz, 7uz, 64uz, 1'000uz })
+		{
+			const auto r4 = engine.run(pool4, shocks, grain);
+			EXPECT_EQ(r4.pnl, r1.pnl);
+			EXPECT_EQ(r4.position_pnl, r1.position_pnl);
+		}
+	}
+
+	TEST(scenario_engine, run3)
+	{
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto quote = debt_security::quote{ 2008y / May / 21d, face, 6u };
+
+		auto engine = scenario_engine{ quote };
+		engine.add(_LTN<cpp_dec_float_50>(2010y / July / 1d), cpp_dec_float_50{ 1'000 }, from_percent(cpp_dec_float_50{ "14.36" }));
+		EXPECT_EQ(engine.value(), cpp_dec_float_50{ "753.315323" });
+
+		auto shocks = yield_shocks<cpp_dec_float_50>{ 1uz };
+		shocks.add_parallel(cpp_dec_float_50{ 0 });
+
+		auto pool = work_stealing_pool{ 2u };
+		const auto r = engine.run(pool, shocks, 1uz);
+		EXPECT_EQ(r.pnl.front(), cpp_dec_float_50{ 0 });
+
+		const auto wrong = yield_shocks<cpp_dec_float_50>{ 2uz };
+		EXPECT_THROW(engine.run(pool, wrong, 1uz), invalid_argument);
+		EXPECT_THROW(engine.run(pool, shocks, 0uz), invalid_argument);
+	}
+
+}
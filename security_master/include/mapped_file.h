@@ -0,0 +1,166 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cerrno>
+#include <span>
+#include <utility>
+#include <filesystem>
+#include <system_error>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace debt_security
+{
+
+	// whole file mapped read only into memory (pages are only read from disk when they are touched)
+	class mapped_file final
+	{
+
+	public:
+
+		mapped_file() noexcept = default;
+
+		explicit mapped_file(const std::filesystem::path& path);
+
+		mapped_file(const mapped_file&) = delete;
+		mapped_file(mapped_file&& other) noexcept;
+
+		auto operator=(const mapped_file&) -> mapped_file& = delete;
+		auto operator=(mapped_file&& other) noexcept -> mapped_file&;
+
+		~mapped_file();
+
+	public:
+
+		auto bytes() const noexcept -> std::span<const std::byte>; // page aligned
+
+	private:
+
+		auto _unmap() noexcept -> void;
+
+	private:
+
+		const std::byte* data_{ nullptr };
+		std::size_t size_{ 0uz };
+
+	};
+
+
+	inline mapped_file::mapped_file(const std::filesystem::path& path)
+	{
+		const auto size = static_cast<std::size_t>(std::filesystem::file_size(path)); // throws if there is no file
+		if (size == 0uz)
+			return; // an empty file cannot be mapped, but there is nothing to map anyway
+
+#if defined(_WIN32)
+		const auto file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			throw std::system_error{ static_cast<int>(::GetLastError()), std::system_category(), "Cannot open " + path.string() };
+
+		const auto mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		const auto mapping_error = ::GetLastError();
+		::CloseHandle(file); // the mapping keeps the file open
+		if (mapping == nullptr)
+			throw std::system_error{ static_cast<int>(mapping_error), std::system_category(), "Cannot map " + path.string() };
+
+		const auto data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		const auto view_error = ::GetLastError();
+		::CloseHandle(mapping); // and the view keeps the mapping
+		if (data == nullptr)
+			throw std::system_error{ static_cast<int>(view_error), std::system_category(), "Cannot map " + path.string() };
+#else
+		const auto file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (file == -1)
+			throw std::system_error{ errno, std::generic_category(), "Cannot open " + path.string() };
+
+		const auto data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+		const auto map_error = errno;
+		::close(file); // the mapping keeps the file open
+		if (data == MAP_FAILED)
+			throw std::system_error{ map_error, std::generic_category(), "Cannot map " + path.string() };
+#endif
+
+		data_ = static_cast<const std::byte*>(data);
+		size_ = size;
+	}
+
+	inline mapped_file::mapped_file(mapped_file&& other) noexcept :
+		data_{ std::exchange(other.data_, nullptr) },
+		size_{ std::exchange(other.size_, 0uz) }
+	{
+	}
+
+	inline auto mapped_file::operator=(mapped_file&& other) noexcept -> mapped_file&
+	{
+		if (this != &other)
+		{
+			_unmap();
+
+			data_ = std::exchange(other.data_, nullptr);
+			size_ = std::exchange(other.size_, 0uz);
+		}
+
+		return *this;
+	}
+
+	inline mapped_file::~mapped_file()
+	{
+		_unmap();
+	}
+
+
+	inline auto mapped_file::bytes() const noexcept -> std::span<const std::byte>
+	{
+		return std::span{ data_, size_ };
+	}
+
+
+	inline auto mapped_file::_unmap() noexcept -> void
+	{
+		if (data_ == nullptr)
+			return;
+
+#if defined(_WIN32)
+		::UnmapViewOfFile(data_);
+#else
+		::munmap(const_cast<std::byte*>(data_), size_);
+#endif
+	}
+
+}
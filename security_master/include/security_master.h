@@ -0,0 +1,588 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <array>
+#include <algorithm>
+#include <limits>
+#include <bit>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <span>
+#include <optional>
+#include <utility>
+#include <functional>
+#include <type_traits>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include <calendar.h>
+
+#include <frequency.h>
+
+#include <flow_block.h>
+#include <shared_calendar.h>
+#include <bill.h>
+#include <bond.h>
+#include <bond_flow_view.h>
+
+#include "mapped_file.h"
+
+
+namespace debt_security
+{
+
+	enum class security_kind : std::uint8_t
+	{
+		bill,
+		bond
+	};
+
+
+	// static data of a single instrument, as given to write_security_master
+	template<typename T = double>
+	struct security_record final
+	{
+		security_kind kind{};
+		std::chrono::year_month_day issue_date{};
+		std::chrono::year_month_day maturity_date{};
+		fin_calendar::frequency frequency{}; // bonds only
+		T coupon{}; // bonds only, as quoted on the market (as in bond)
+		T face{ 100 };
+		std::optional<unsigned int> round_flows{}; // bonds only
+		std::string calendar{}; // name, as in gregorian::static_data::locate_calendar
+	};
+
+
+	// finds calendars by the names the security master was written with
+	using calendar_locator = std::function<const gregorian::calendar&(const std::string&)>;
+
+
+	template<typename T>
+	class security_master;
+
+
+	// a single instrument of a security master, read straight from the mapped file
+	// (valid as long as the security master is)
+	template<typename T = double>
+	class security_view final
+	{
+
+	public:
+
+		explicit security_view(const security_master<T>& master, std::size_t i) noexcept;
+
+	public:
+
+		auto get_kind() const noexcept -> security_kind;
+		auto get_issue_date() const noexcept -> std::chrono::year_month_day;
+		auto get_maturity_date() const noexcept -> std::chrono::year_month_day;
+		auto get_frequency() const noexcept -> fin_calendar::frequency;
+		auto get_coupon() const -> T;
+		auto get_face() const -> T;
+		auto get_round_flows() const noexcept -> std::optional<unsigned int>;
+		auto get_calendar() const noexcept -> const gregorian::calendar&;
+		auto get_shared_calendar() const noexcept -> const shared_calendar&;
+
+	public:
+
+		// what bond_flow_view works out the flows from, so a bond can be priced without building it
+		// (the terms refer to the calendar of the security master)
+		auto terms() const -> bond_terms<T>;
+
+		// the instrument itself, sharing the calendar of the security master
+		auto make_bill() const -> bill<T>;
+		auto make_bond() const -> bond<T>;
+
+	private:
+
+		const security_master<T>* master_;
+		std::size_t i_;
+
+	};
+
+
+	// instrument static data from a file written by write_security_master,
+	// mapped into memory rather than read, with a column for each field
+	// (so nothing is parsed, and only calendars are looked up - once per calendar rather than once per instrument)
+	template<typename T = double>
+	class security_master final
+	{
+
+	public:
+
+		explicit security_master(const std::filesystem::path& path, const calendar_locator& locate);
+
+	public:
+
+		auto size() const noexcept -> std::size_t;
+		auto empty() const noexcept -> bool;
+
+		auto operator[](std::size_t i) const noexcept -> security_view<T>;
+
+	public:
+
+		// the columns as they are in the file, for loops which only need some of the fields
+		auto get_issue_days() const noexcept -> std::span<const std::int32_t>; // serial days, as in flow_block
+		auto get_maturity_days() const noexcept -> std::span<const std::int32_t>;
+		auto get_kinds() const noexcept -> std::span<const security_kind>;
+
+	private:
+
+		friend class security_view<T>;
+
+		mapped_file file_;
+
+		std::span<const std::int64_t> coupons_{};
+		std::span<const std::int64_t> faces_{};
+		std::span<const std::int32_t> issue_days_{};
+		std::span<const std::int32_t> maturity_days_{};
+		std::span<const std::uint16_t> calendar_ids_{};
+		std::span<const security_kind> kinds_{};
+		std::span<const std::uint8_t> frequencies_{};
+		std::span<const std::uint8_t> round_flows_{};
+
+		std::vector<shared_calendar> calendars_{};
+
+	};
+
+
+	template<typename T>
+	auto write_security_master(
+		const std::filesystem::path& path,
+		std::span<const security_record<T>> records
+	) -> void;
+
+	template<typename T>
+	auto write_security_master(
+		const std::filesystem::path& path,
+		const std::vector<security_record<T>>& records
+	) -> void;
+
+
+	// the file: a header, then a column for each field (aligned to the size of its elements, so it can be used in place),
+	// then the calendar names - all little endian
+	namespace _security_master
+	{
+
+		static_assert(std::endian::native == std::endian::little, "Security master files are little endian");
+
+		inline constexpr auto magic = std::array<char, 8uz>{ 'D', 'S', 'S', 'E', 'C', 'M', 'S', 'T' };
+		inline constexpr auto version = std::uint32_t{ 1 }; // also changes if fin_calendar::frequency does
+
+		// coupons and faces are integers in units of 10^-8, so decimal static data is stored exactly
+		inline constexpr auto decimal_places = 8u;
+		inline constexpr auto decimal_scale = std::int64_t{ 100'000'000 };
+
+		inline constexpr auto no_round_flows = std::uint8_t{ 0xFF };
+
+		// none for a bill, and the coupon frequencies of a bond
+		inline constexpr auto known_frequencies = std::array{
+			fin_calendar::frequency{},
+			fin_calendar::Annual,
+			fin_calendar::SemiAnnual,
+			fin_calendar::Quarterly,
+			fin_calendar::Monthly
+		};
+
+		inline auto is_known_frequency(std::uint8_t f) noexcept -> bool
+		{
+			return std::ranges::any_of(known_frequencies, [f](const auto known) { return std::to_underlying(known) == f; });
+		}
+
+		struct header final
+		{
+			std::array<char, 8uz> magic;
+			std::uint32_t version;
+			std::uint32_t count; // of instruments
+			std::uint32_t calendar_count;
+			std::uint32_t reserved;
+
+			// where each column starts in the file
+			std::uint64_t coupons; // std::int64_t
+			std::uint64_t faces; // std::int64_t
+			std::uint64_t issue_days; // std::int32_t
+			std::uint64_t maturity_days; // std::int32_t
+			std::uint64_t calendar_name_ends; // std::uint32_t for each calendar (where its name ends in calendar_names)
+			std::uint64_t calendar_ids; // std::uint16_t
+			std::uint64_t kinds; // security_kind
+			std::uint64_t frequencies; // std::uint8_t
+			std::uint64_t round_flows; // std::uint8_t
+			std::uint64_t calendar_names; // char
+
+			std::uint64_t size; // of the whole file
+		};
+
+		static_assert(std::is_trivially_copyable_v<header>);
+
+
+		template<typename E>
+		auto column(std::span<const std::byte> bytes, std::uint64_t offset, std::size_t count) -> std::span<const E>
+		{
+			if (offset % alignof(E) != 0u || offset > bytes.size() || (bytes.size() - offset) / sizeof(E) < count)
+				throw std::runtime_error{ "Security master column is out of the file" };
+
+			return std::span{ reinterpret_cast<const E*>(bytes.data() + offset), count }; // the mapping is page aligned
+		}
+
+
+		template<typename T>
+		auto to_units(const T& value) -> std::int64_t
+		{
+			const auto units = std::llround(static_cast<double>(T{ value * T{ decimal_scale } }));
+			if (T{ static_cast<T>(units) / T{ decimal_scale } } != value)
+				throw std::invalid_argument{ "Security master only stores up to 8 decimal places" };
+
+			return static_cast<std::int64_t>(units);
+		}
+
+		template<typename T>
+		auto from_units(std::int64_t units) -> T
+		{
+			return T{ static_cast<T>(units) / T{ decimal_scale } }; // exact for decimals
+		}
+
+
+		inline auto align(std::uint64_t offset, std::size_t alignment) noexcept -> std::uint64_t
+		{
+			return (offset + alignment - 1u) / alignment * alignment;
+		}
+
+		template<typename E>
+		auto append(std::vector<std::byte>& bytes, std::span<const E> elements) -> std::uint64_t
+		{
+			const auto offset = align(bytes.size(), alignof(E));
+			bytes.resize(offset + elements.size_bytes());
+			if (!elements.empty())
+				std::memcpy(bytes.data() + offset, elements.data(), elements.size_bytes());
+
+			return offset;
+		}
+
+	}
+
+
+	template<typename T>
+	security_view<T>::security_view(const security_master<T>& master, std::size_t i) noexcept :
+		master_{ &master },
+		i_{ i }
+	{
+	}
+
+
+	template<typename T>
+	auto security_view<T>::get_kind() const noexcept -> security_kind
+	{
+		return master_->kinds_[i_];
+	}
+
+	template<typename T>
+	auto security_view<T>::get_issue_date() const noexcept -> std::chrono::year_month_day
+	{
+		return from_serial_day(master_->issue_days_[i_]);
+	}
+
+	template<typename T>
+	auto security_view<T>::get_maturity_date() const noexcept -> std::chrono::year_month_day
+	{
+		return from_serial_day(master_->maturity_days_[i_]);
+	}
+
+	template<typename T>
+	auto security_view<T>::get_frequency() const noexcept -> fin_calendar::frequency
+	{
+		return static_cast<fin_calendar::frequency>(master_->frequencies_[i_]);
+	}
+
+	template<typename T>
+	auto security_view<T>::get_coupon() const -> T
+	{
+		return _security_master::from_units<T>(master_->coupons_[i_]);
+	}
+
+	template<typename T>
+	auto security_view<T>::get_face() const -> T
+	{
+		return _security_master::from_units<T>(master_->faces_[i_]);
+	}
+
+	template<typename T>
+	auto security_view<T>::get_round_flows() const noexcept -> std::optional<unsigned int>
+	{
+		const auto round_flows = master_->round_flows_[i_];
+		if (round_flows == _security_master::no_round_flows)
+			return std::nullopt;
+		else
+			return round_flows;
+	}
+
+	template<typename T>
+	auto security_view<T>::get_calendar() const noexcept -> const gregorian::calendar&
+	{
+		return *get_shared_calendar();
+	}
+
+	template<typename T>
+	auto security_view<T>::get_shared_calendar() const noexcept -> const shared_calendar&
+	{
+		return master_->calendars_[master_->calendar_ids_[i_]];
+	}
+
+
+	template<typename T>
+	auto security_view<T>::terms() const -> bond_terms<T>
+	{
+		if (get_kind() != security_kind::bond)
+			throw std::logic_error{ "Only bonds have coupon terms" };
+
+		const auto face = get_face();
+
+		return bond_terms<T>{
+			get_issue_date(),
+			get_maturity_date(),
+			get_frequency(),
+			get_calendar(),
+			bond_coupon_amount(face, get_coupon(), get_frequency(), get_round_flows()),
+			face
+		};
+	}
+
+	template<typename T>
+	auto security_view<T>::make_bill() const -> bill<T>
+	{
+		if (get_kind() != security_kind::bill)
+			throw std::logic_error{ "Security is not a bill" };
+
+		return bill<T>{ get_issue_date(), get_maturity_date(), get_shared_calendar(), get_face() };
+	}
+
+	template<typename T>
+	auto security_view<T>::make_bond() const -> bond<T>
+	{
+		if (get_kind() != security_kind::bond)
+			throw std::logic_error{ "Security is not a bond" };
+
+		return bond<T>{
+			get_issue_date(),
+			get_maturity_date(),
+			get_frequency(),
+			get_coupon(),
+			get_shared_calendar(),
+			get_face(),
+			get_round_flows()
+		};
+	}
+
+
+	template<typename T>
+	security_master<T>::security_master(const std::filesystem::path& path, const calendar_locator& locate) :
+		file_{ path }
+	{
+		namespace sm = _security_master;
+
+		const auto bytes = file_.bytes();
+
+		auto h = sm::header{};
+		if (bytes.size() < sizeof(h))
+			throw std::runtime_error{ "Not a security master: " + path.string() };
+
+		std::memcpy(&h, bytes.data(), sizeof(h));
+		if (h.magic != sm::magic)
+			throw std::runtime_error{ "Not a security master: " + path.string() };
+		if (h.version != sm::version)
+			throw std::runtime_error{ "Unsupported security master version: " + std::to_string(h.version) };
+		if (h.size != bytes.size())
+			throw std::runtime_error{ "Security master is truncated: " + path.string() };
+
+		const auto count = static_cast<std::size_t>(h.count);
+		coupons_ = sm::column<std::int64_t>(bytes, h.coupons, count);
+		faces_ = sm::column<std::int64_t>(bytes, h.faces, count);
+		issue_days_ = sm::column<std::int32_t>(bytes, h.issue_days, count);
+		maturity_days_ = sm::column<std::int32_t>(bytes, h.maturity_days, count);
+		calendar_ids_ = sm::column<std::uint16_t>(bytes, h.calendar_ids, count);
+		kinds_ = sm::column<security_kind>(bytes, h.kinds, count);
+		frequencies_ = sm::column<std::uint8_t>(bytes, h.frequencies, count);
+		round_flows_ = sm::column<std::uint8_t>(bytes, h.round_flows, count);
+
+		const auto name_ends = sm::column<std::uint32_t>(bytes, h.calendar_name_ends, h.calendar_count);
+		const auto names = sm::column<char>(bytes, h.calendar_names, name_ends.empty() ? 0uz : name_ends.back());
+
+		// only a handful of calendars, so we can afford to check everything else here
+		calendars_.reserve(name_ends.size());
+		auto begin = 0uz;
+		for (const auto end : name_ends)
+		{
+			if (end < begin || end > names.size())
+				throw std::runtime_error{ "Security master calendar names are corrupt" };
+
+			calendars_.push_back(intern_calendar(locate(std::string{ names.data() + begin, names.data() + end })));
+			begin = end;
+		}
+
+		for (const auto id : calendar_ids_)
+			if (id >= calendars_.size())
+				throw std::runtime_error{ "Security master refers to an unknown calendar" };
+
+		for (const auto kind : kinds_)
+			if (kind != security_kind::bill && kind != security_kind::bond)
+				throw std::runtime_error{ "Security master has an unknown kind of instrument" };
+
+		for (const auto frequency : frequencies_)
+			if (!sm::is_known_frequency(frequency))
+				throw std::runtime_error{ "Security master has an unknown coupon frequency" };
+	}
+
+
+	template<typename T>
+	auto security_master<T>::size() const noexcept -> std::size_t
+	{
+		return kinds_.size();
+	}
+
+	template<typename T>
+	auto security_master<T>::empty() const noexcept -> bool
+	{
+		return kinds_.empty();
+	}
+
+	template<typename T>
+	auto security_master<T>::operator[](std::size_t i) const noexcept -> security_view<T>
+	{
+		return security_view<T>{ *this, i };
+	}
+
+
+	template<typename T>
+	auto security_master<T>::get_issue_days() const noexcept -> std::span<const std::int32_t>
+	{
+		return issue_days_;
+	}
+
+	template<typename T>
+	auto security_master<T>::get_maturity_days() const noexcept -> std::span<const std::int32_t>
+	{
+		return maturity_days_;
+	}
+
+	template<typename T>
+	auto security_master<T>::get_kinds() const noexcept -> std::span<const security_kind>
+	{
+		return kinds_;
+	}
+
+
+	template<typename T>
+	auto write_security_master(
+		const std::filesystem::path& path,
+		std::span<const security_record<T>> records
+	) -> void
+	{
+		namespace sm = _security_master;
+
+		auto coupons = std::vector<std::int64_t>{};
+		auto faces = std::vector<std::int64_t>{};
+		auto issue_days = std::vector<std::int32_t>{};
+		auto maturity_days = std::vector<std::int32_t>{};
+		auto calendar_ids = std::vector<std::uint16_t>{};
+		auto kinds = std::vector<security_kind>{};
+		auto frequencies = std::vector<std::uint8_t>{};
+		auto round_flows = std::vector<std::uint8_t>{};
+
+		auto calendar_names = std::vector<std::string>{}; // we only expect a handful of calendars
+
+		for (const auto& record : records)
+		{
+			if (record.round_flows && *record.round_flows >= sm::no_round_flows)
+				throw std::invalid_argument{ "Too many decimal places to round flows to" };
+
+			auto id = static_cast<std::size_t>(std::ranges::find(calendar_names, record.calendar) - calendar_names.begin());
+			if (id == calendar_names.size())
+			{
+				if (id > std::size_t{ std::numeric_limits<std::uint16_t>::max() })
+					throw std::invalid_argument{ "Too many calendars for a security master" };
+
+				calendar_names.push_back(record.calendar);
+			}
+
+			coupons.push_back(sm::to_units(record.coupon));
+			faces.push_back(sm::to_units(record.face));
+			issue_days.push_back(to_serial_day(record.issue_date));
+			maturity_days.push_back(to_serial_day(record.maturity_date));
+			calendar_ids.push_back(static_cast<std::uint16_t>(id));
+			kinds.push_back(record.kind);
+			frequencies.push_back(static_cast<std::uint8_t>(std::to_underlying(record.frequency)));
+			round_flows.push_back(record.round_flows ? static_cast<std::uint8_t>(*record.round_flows) : sm::no_round_flows);
+		}
+
+		auto names = std::string{};
+		auto name_ends = std::vector<std::uint32_t>{};
+		for (const auto& name : calendar_names)
+		{
+			names += name;
+			name_ends.push_back(static_cast<std::uint32_t>(names.size()));
+		}
+
+		auto h = sm::header{};
+		h.magic = sm::magic;
+		h.version = sm::version;
+		h.count = static_cast<std::uint32_t>(records.size());
+		h.calendar_count = static_cast<std::uint32_t>(calendar_names.size());
+
+		// widest columns first, so there is as little padding as possible
+		auto bytes = std::vector<std::byte>(sizeof(h));
+		h.coupons = sm::append(bytes, std::span<const std::int64_t>{ coupons });
+		h.faces = sm::append(bytes, std::span<const std::int64_t>{ faces });
+		h.issue_days = sm::append(bytes, std::span<const std::int32_t>{ issue_days });
+		h.maturity_days = sm::append(bytes, std::span<const std::int32_t>{ maturity_days });
+		h.calendar_name_ends = sm::append(bytes, std::span<const std::uint32_t>{ name_ends });
+		h.calendar_ids = sm::append(bytes, std::span<const std::uint16_t>{ calendar_ids });
+		h.kinds = sm::append(bytes, std::span<const security_kind>{ kinds });
+		h.frequencies = sm::append(bytes, std::span<const std::uint8_t>{ frequencies });
+		h.round_flows = sm::append(bytes, std::span<const std::uint8_t>{ round_flows });
+		h.calendar_names = sm::append(bytes, std::span<const char>{ names });
+		h.size = bytes.size();
+
+		std::memcpy(bytes.data(), &h, sizeof(h));
+
+		auto file = std::ofstream{ path, std::ios::binary | std::ios::trunc };
+		file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		if (!file.flush())
+			throw std::runtime_error{ "Cannot write security master: " + path.string() };
+	}
+
+	template<typename T>
+	auto write_security_master(
+		const std::filesystem::path& path,
+		const std::vector<security_record<T>>& records
+	) -> void
+	{
+		write_security_master(path, std::span<const security_record<T>>{ records });
+	}
+
+}
@@ -0,0 +1,316 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <boost/multiprecision/cpp_dec_float.hpp>
+
+#include <security_master.h>
+#include <bond_flow_view.h>
+#include <ANBIMA.h>
+#include <quote.h>
+
+#include <resets_math.h>
+
+#include <static_data.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <filesystem>
+#include <stdexcept>
+
+using namespace std;
+using namespace std::chrono;
+using namespace boost::multiprecision;
+using namespace gregorian;
+using namespace fin_calendar;
+using namespace reset;
+using namespace gregorian::static_data;
+
+
+namespace debt_security
+{
+
+	// removed at the end of the test
+	class _temporary_file final
+	{
+
+	public:
+
+		explicit _temporary_file(const string& name) :
+			path_{ filesystem::temp_directory_path() / ("debt_security_" + name) }
+		{
+		}
+
+		~_temporary_file()
+		{
+			auto error = error_code{};
+			filesystem::remove(path_, error);
+		}
+
+	public:
+
+		auto path() const noexcept -> const filesystem::path& { return path_; }
+
+	private:
+
+		filesystem::path path_;
+
+	};
+
+
+	static auto _records() -> vector<security_record<double>>
+	{
+		return vector{
+			security_record<double>{
+				.kind = security_kind::bill,
+				.issue_date = 2007y / July / 1d,
+				.maturity_date = 2010y / July / 1d,
+				.face = 1'000.0,
+				.calendar = "America/ANBIMA"s
+			},
+			security_record<double>{
+				.kind = security_kind::bond,
+				.issue_date = 2008y / January / 1d,
+				.maturity_date = 2014y / January / 1d,
+				.frequency = SemiAnnual,
+				.coupon = 10.0,
+				.face = 1'000.0,
+				.round_flows = 5u,
+				.calendar = "America/ANBIMA"s
+			}
+		};
+	}
+
+
+	TEST(security_master, round_trip1)
+	{
+		const auto file = _temporary_file{ "round_trip1.dssm"s };
+
+		const auto records = _records();
+		write_security_master(file.path(), records);
+
+		const auto master = security_master{ file.path(), locate_calendar };
+		ASSERT_EQ(master.size(), records.size());
+
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+
+		const auto LTN = master[0];
+		EXPECT_EQ(LTN.get_kind(), security_kind::bill);
+		EXPECT_EQ(LTN.get_issue_date(), 2007y / July / 1d);
+		EXPECT_EQ(LTN.get_maturity_date(), 2010y / July / 1d);
+		EXPECT_EQ(LTN.get_face(), 1'000.0);
+		EXPECT_EQ(LTN.get_round_flows(), nullopt);
+		EXPECT_EQ(LTN.get_calendar(), calendar);
+
+		const auto NTN_F = master[1];
+		EXPECT_EQ(NTN_F.get_kind(), security_kind::bond);
+		EXPECT_EQ(NTN_F.get_issue_date(), 2008y / January / 1d);
+		EXPECT_EQ(NTN_F.get_maturity_date(), 2014y / January / 1d);
+		EXPECT_EQ(NTN_F.get_frequency(), SemiAnnual);
+		EXPECT_EQ(NTN_F.get_coupon(), 10.0);
+		EXPECT_EQ(NTN_F.get_face(), 1'000.0);
+		EXPECT_EQ(NTN_F.get_round_flows(), 5u);
+
+		// a single calendar for both
+		EXPECT_EQ(LTN.get_shared_calendar(), NTN_F.get_shared_calendar());
+	}
+
+	TEST(security_master, round_trip2)
+	{
+		const auto file = _temporary_file{ "round_trip2.dssm"s };
+
+		const auto records = vector{
+			security_record<cpp_dec_float_50>{
+				.kind = security_kind::bond,
+				.issue_date = 2008y / January / 1d,
+				.maturity_date = 2014y / January / 1d,
+				.frequency = Annual,
+				.coupon = cpp_dec_float_50{ "6.12345678" },
+				.face = cpp_dec_float_50{ "1000.00000001" },
+				.calendar = "America/ANBIMA"s
+			}
+		};
+		write_security_master(file.path(), records);
+
+		const auto master = security_master<cpp_dec_float_50>{ file.path(), locate_calendar };
+		ASSERT_EQ(master.size(), 1uz);
+
+		// decimals are stored exactly
+		EXPECT_EQ(master[0].get_coupon(), cpp_dec_float_50{ "6.12345678" });
+		EXPECT_EQ(master[0].get_face(), cpp_dec_float_50{ "1000.00000001" });
+		EXPECT_EQ(master[0].get_frequency(), Annual);
+		EXPECT_EQ(master[0].get_round_flows(), nullopt);
+	}
+
+	TEST(security_master, round_trip3)
+	{
+		const auto file = _temporary_file{ "round_trip3.dssm"s };
+
+		write_security_master(file.path(), vector<security_record<double>>{});
+
+		const auto master = security_master{ file.path(), locate_calendar };
+		EXPECT_TRUE(master.empty());
+		EXPECT_TRUE(master.get_issue_days().empty());
+	}
+
+	TEST(security_master, columns1)
+	{
+		const auto file = _temporary_file{ "columns1.dssm"s };
+
+		write_security_master(file.path(), _records());
+
+		const auto master = security_master{ file.path(), locate_calendar };
+
+		const auto issue_days = master.get_issue_days();
+		const auto maturity_days = master.get_maturity_days();
+		const auto kinds = master.get_kinds();
+		ASSERT_EQ(issue_days.size(), 2uz);
+		EXPECT_EQ(issue_days[0], to_serial_day(2007y / July / 1d));
+		EXPECT_EQ(maturity_days[1], to_serial_day(2014y / January / 1d));
+		EXPECT_EQ(kinds[1], security_kind::bond);
+	}
+
+	TEST(security_master, price1)
+	{
+		const auto file = _temporary_file{ "price1.dssm"s };
+
+		const auto records = _records();
+		write_security_master(file.path(), records);
+
+		const auto master = security_master{ file.path(), locate_calendar };
+
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto NTN_F = bond{
+			records[1].issue_date,
+			records[1].maturity_date,
+			records[1].frequency,
+			records[1].coupon,
+			calendar,
+			records[1].face,
+			records[1].round_flows
+		};
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto quote = debt_security::quote{ settlement_date, 1'000.0, 6u };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = from_percent(13.66);
+
+		// straight from the file, without building the bond
+		const auto view = master[1];
+		const auto terms = view.terms();
+		const auto price = ANBIMA.price(yield, bond_flow_view{ terms }, view.get_calendar(), quote);
+		EXPECT_EQ(price, 903.075616);
+		EXPECT_EQ(price, ANBIMA.price(yield, NTN_F, quote));
+
+		EXPECT_EQ(ANBIMA.price(yield, view.make_bond(), quote), price);
+
+		const auto LTN = master[0].make_bill();
+		EXPECT_EQ(LTN.get_face(), 1'000.0);
+		EXPECT_EQ(LTN.get_shared_calendar(), view.get_shared_calendar());
+	}
+
+	TEST(security_master, invalid1)
+	{
+		const auto file = _temporary_file{ "invalid1.dssm"s };
+
+		{
+			auto text = ofstream{ file.path() };
+			text << "LTN,2007-07-01,2010-07-01,1000,America/ANBIMA\n";
+		}
+		EXPECT_THROW(security_master(file.path(), locate_calendar), runtime_error);
+
+		write_security_master(file.path(), _records());
+		filesystem::resize_file(file.path(), filesystem::file_size(file.path()) - 1u);
+		EXPECT_THROW(security_master(file.path(), locate_calendar), runtime_error);
+
+		EXPECT_THROW(security_master(file.path().string() + ".missing"s, locate_calendar), filesystem::filesystem_error);
+
+		// the first calendar name ends after the last one (so past the names)
+		auto records = _records();
+		records[1].calendar = "America/ANBIMA (again)"s;
+		write_security_master(file.path(), records);
+		{
+			auto f = fstream{ file.path(), ios::in | ios::out | ios::binary };
+			auto h = _security_master::header{};
+			f.read(reinterpret_cast<char*>(&h), sizeof(h));
+
+			auto ends = array<uint32_t, 2uz>{};
+			f.seekg(static_cast<streamoff>(h.calendar_name_ends));
+			f.read(reinterpret_cast<char*>(ends.data()), sizeof(ends));
+
+			ends[0] = ends[1] + 1'000u;
+			f.seekp(static_cast<streamoff>(h.calendar_name_ends));
+			f.write(reinterpret_cast<const char*>(ends.data()), sizeof(ends));
+		}
+		auto located = 0;
+		const auto counting = [&](const string&) -> const calendar& { ++located; return locate_calendar("America/ANBIMA"s); };
+		EXPECT_THROW(security_master(file.path(), counting), runtime_error);
+		EXPECT_EQ(located, 0); // nothing was read past the names
+	}
+
+	TEST(security_master, invalid3)
+	{
+		const auto file = _temporary_file{ "invalid3.dssm"s };
+
+		write_security_master(file.path(), _records());
+		EXPECT_NO_THROW(security_master(file.path(), locate_calendar));
+
+		// a frequency byte which is not a frequency at all
+		{
+			auto f = fstream{ file.path(), ios::in | ios::out | ios::binary };
+			auto h = _security_master::header{};
+			f.read(reinterpret_cast<char*>(&h), sizeof(h));
+
+			const auto bad = uint8_t{ 0xEE };
+			f.seekp(static_cast<streamoff>(h.frequencies + 1u));
+			f.write(reinterpret_cast<const char*>(&bad), sizeof(bad));
+		}
+		EXPECT_THROW(security_master(file.path(), locate_calendar), runtime_error);
+	}
+
+	TEST(security_master, invalid2)
+	{
+		const auto file = _temporary_file{ "invalid2.dssm"s };
+
+		auto records = _records();
+		records[1].coupon = 10.123456789;
+		EXPECT_THROW(write_security_master(file.path(), records), invalid_argument);
+
+		write_security_master(file.path(), _records());
+
+		// calendars are only looked up when the file is opened
+		const auto unknown = [](const string& name) -> const calendar& { throw out_of_range{ name }; };
+		EXPECT_THROW(security_master(file.path(), unknown), out_of_range);
+
+		const auto master = security_master{ file.path(), locate_calendar };
+		EXPECT_THROW(master[0].make_bond(), logic_error);
+		EXPECT_THROW(master[0].terms(), logic_error);
+		EXPECT_THROW(master[1].make_bill(), logic_error);
+	}
+
+}
@@ -0,0 +1,415 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <compare>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <ranges>
+#include <optional>
+#include <utility>
+#include <limits>
+#include <stdexcept>
+
+#include <bill.h>
+#include <bond.h>
+
+
+namespace debt_security
+{
+
+	// handle of an instrument in a security_registry - an index into the arena of its kind
+	// (so it stays the same as more instruments are registered, and is cheap to keep in every book)
+	template<typename Instrument>
+	struct registry_id final
+	{
+		std::uint32_t index;
+
+		auto operator<=>(const registry_id&) const noexcept = default;
+	};
+
+
+	namespace _security_registry
+	{
+
+		// gives the instrument of an id
+		template<typename Instrument>
+		class resolver final
+		{
+
+		public:
+
+			explicit resolver(const std::vector<Instrument>& arena) noexcept : arena_{ &arena } {}
+
+		public:
+
+			auto operator()(registry_id<Instrument> id) const noexcept -> const Instrument& { return (*arena_)[id.index]; }
+
+		private:
+
+			const std::vector<Instrument>* arena_;
+
+		};
+
+		// FNV-1a, which is plenty for ISINs and SELIC codes
+		inline auto hash(std::string_view code) noexcept -> std::uint64_t
+		{
+			auto h = std::uint64_t{ 14695981039346656037u };
+			for (const auto c : code)
+			{
+				h ^= static_cast<unsigned char>(c);
+				h *= std::uint64_t{ 1099511628211u };
+			}
+
+			return h;
+		}
+
+	}
+
+
+	// instruments of ids, in the order of the ids (for price_batch and anything else which takes a range of instruments)
+	template<typename Instrument>
+	using resolved_view = std::ranges::transform_view<
+		std::span<const registry_id<Instrument>>,
+		_security_registry::resolver<Instrument>
+	>;
+
+
+	// every instrument once, found by its code (ISIN or SELIC code), with bills and bonds each kept next to each other
+	// (not synchronised: register everything first, then look up and price from as many threads as needed)
+	template<typename T = double>
+	class security_registry final
+	{
+
+	public:
+
+		using bill_id = registry_id<bill<T>>;
+		using bond_id = registry_id<bond<T>>;
+
+	public:
+
+		// the instrument registered under the code already, or the given one registered under it
+		// (throws std::invalid_argument if the code is taken by an instrument of the other kind)
+		auto intern(std::string_view code, bill<T> bill) -> bill_id;
+		auto intern(std::string_view code, bond<T> bond) -> bond_id;
+
+		auto find_bill(std::string_view code) const noexcept -> std::optional<bill_id>;
+		auto find_bond(std::string_view code) const noexcept -> std::optional<bond_id>;
+
+		// references are only good until the next instrument of the kind is registered, but ids are good forever
+		auto operator[](bill_id id) const noexcept -> const bill<T>&;
+		auto operator[](bond_id id) const noexcept -> const bond<T>&;
+
+		auto get_code(bill_id id) const noexcept -> std::string_view;
+		auto get_code(bond_id id) const noexcept -> std::string_view;
+
+		auto resolve(std::span<const bill_id> ids) const noexcept -> resolved_view<bill<T>>;
+		auto resolve(std::span<const bond_id> ids) const noexcept -> resolved_view<bond<T>>;
+
+	public:
+
+		auto size() const noexcept -> std::size_t; // of both kinds together
+
+		auto get_bills() const noexcept -> std::span<const bill<T>>;
+		auto get_bonds() const noexcept -> std::span<const bond<T>>;
+
+		// so the arenas do not move their instruments around as they grow
+		auto reserve(std::size_t bills, std::size_t bonds) -> void;
+
+	private:
+
+		enum class _kind : std::uint8_t
+		{
+			bill,
+			bond
+		};
+
+		struct _entry final
+		{
+			std::uint64_t hash;
+			std::uint32_t code_offset; // into codes_
+			std::uint32_t code_size;
+			std::uint32_t index; // into the arena of the kind
+			_kind kind;
+		};
+
+		auto _code(const _entry& entry) const noexcept -> std::string_view;
+
+		// the entry of the code, if there is one
+		auto _find(std::string_view code, std::uint64_t hash) const noexcept -> const _entry*;
+
+		// registers the code for the next instrument of the kind (the code must not be registered yet)
+		auto _insert(std::string_view code, std::uint64_t hash, _kind kind, std::size_t index) -> void;
+
+		auto _grow() -> void;
+
+	private:
+
+		std::vector<bill<T>> bills_{};
+		std::vector<bond<T>> bonds_{};
+
+		// entries of the instruments of each arena
+		std::vector<std::uint32_t> bill_entries_{};
+		std::vector<std::uint32_t> bond_entries_{};
+
+		std::vector<_entry> entries_{};
+		std::string codes_{}; // all codes one after another, rather than a string each
+
+		// open addressing with linear probing: an entry index + 1 for each slot, or 0 if the slot is empty
+		// (there are always at least twice as many slots as entries, and a power of 2 of them)
+		std::vector<std::uint32_t> slots_{};
+
+	};
+
+
+	template<typename T>
+	auto security_registry<T>::intern(std::string_view code, bill<T> bill) -> bill_id
+	{
+		const auto hash = _security_registry::hash(code);
+		if (const auto entry = _find(code, hash))
+		{
+			if (entry->kind != _kind::bill)
+				throw std::invalid_argument{ "Code is registered for a bond: " + std::string{ code } };
+
+			return bill_id{ entry->index };
+		}
+
+		bills_.push_back(std::move(bill));
+		try
+		{
+			_insert(code, hash, _kind::bill, bills_.size() - 1uz);
+		}
+		catch (...)
+		{
+			bills_.pop_back();
+			throw;
+		}
+
+		return bill_id{ static_cast<std::uint32_t>(bills_.size() - 1uz) };
+	}
+
+	template<typename T>
+	auto security_registry<T>::intern(std::string_view code, bond<T> bond) -> bond_id
+	{
+		const auto hash = _security_registry::hash(code);
+		if (const auto entry = _find(code, hash))
+		{
+			if (entry->kind != _kind::bond)
+				throw std::invalid_argument{ "Code is registered for a bill: " + std::string{ code } };
+
+			return bond_id{ entry->index };
+		}
+
+		bonds_.push_back(std::move(bond));
+		try
+		{
+			_insert(code, hash, _kind::bond, bonds_.size() - 1uz);
+		}
+		catch (...)
+		{
+			bonds_.pop_back();
+			throw;
+		}
+
+		return bond_id{ static_cast<std::uint32_t>(bonds_.size() - 1uz) };
+	}
+
+
+	template<typename T>
+	auto security_registry<T>::find_bill(std::string_view code) const noexcept -> std::optional<bill_id>
+	{
+		const auto entry = _find(code, _security_registry::hash(code));
+		if (entry && entry->kind == _kind::bill)
+			return bill_id{ entry->index };
+		else
+			return std::nullopt;
+	}
+
+	template<typename T>
+	auto security_registry<T>::find_bond(std::string_view code) const noexcept -> std::optional<bond_id>
+	{
+		const auto entry = _find(code, _security_registry::hash(code));
+		if (entry && entry->kind == _kind::bond)
+			return bond_id{ entry->index };
+		else
+			return std::nullopt;
+	}
+
+
+	template<typename T>
+	auto security_registry<T>::operator[](bill_id id) const noexcept -> const bill<T>&
+	{
+		return bills_[id.index];
+	}
+
+	template<typename T>
+	auto security_registry<T>::operator[](bond_id id) const noexcept -> const bond<T>&
+	{
+		return bonds_[id.index];
+	}
+
+
+	template<typename T>
+	auto security_registry<T>::get_code(bill_id id) const noexcept -> std::string_view
+	{
+		return _code(entries_[bill_entries_[id.index]]);
+	}
+
+	template<typename T>
+	auto security_registry<T>::get_code(bond_id id) const noexcept -> std::string_view
+	{
+		return _code(entries_[bond_entries_[id.index]]);
+	}
+
+
+	template<typename T>
+	auto security_registry<T>::resolve(std::span<const bill_id> ids) const noexcept -> resolved_view<bill<T>>
+	{
+		return resolved_view<bill<T>>{ ids, _security_registry::resolver<bill<T>>{ bills_ } };
+	}
+
+	template<typename T>
+	auto security_registry<T>::resolve(std::span<const bond_id> ids) const noexcept -> resolved_view<bond<T>>
+	{
+		return resolved_view<bond<T>>{ ids, _security_registry::resolver<bond<T>>{ bonds_ } };
+	}
+
+
+	template<typename T>
+	auto security_registry<T>::size() const noexcept -> std::size_t
+	{
+		return entries_.size();
+	}
+
+	template<typename T>
+	auto security_registry<T>::get_bills() const noexcept -> std::span<const bill<T>>
+	{
+		return bills_;
+	}
+
+	template<typename T>
+	auto security_registry<T>::get_bonds() const noexcept -> std::span<const bond<T>>
+	{
+		return bonds_;
+	}
+
+	template<typename T>
+	auto security_registry<T>::reserve(std::size_t bills, std::size_t bonds) -> void
+	{
+		bills_.reserve(bills);
+		bonds_.reserve(bonds);
+		bill_entries_.reserve(bills);
+		bond_entries_.reserve(bonds);
+		entries_.reserve(bills + bonds);
+
+		while (slots_.size() < 2uz * (bills + bonds))
+			_grow();
+	}
+
+
+	template<typename T>
+	auto security_registry<T>::_code(const _entry& entry) const noexcept -> std::string_view
+	{
+		return std::string_view{ codes_ }.substr(entry.code_offset, entry.code_size);
+	}
+
+	template<typename T>
+	auto security_registry<T>::_find(std::string_view code, std::uint64_t hash) const noexcept -> const _entry*
+	{
+		if (slots_.empty())
+			return nullptr;
+
+		const auto mask = slots_.size() - 1uz;
+		for (auto slot = static_cast<std::size_t>(hash) & mask; slots_[slot] != 0u; slot = (slot + 1uz) & mask)
+		{
+			const auto& entry = entries_[slots_[slot] - 1u];
+			if (entry.hash == hash && _code(entry) == code)
+				return &entry;
+		}
+
+		return nullptr;
+	}
+
+	template<typename T>
+	auto security_registry<T>::_insert(std::string_view code, std::uint64_t hash, _kind kind, std::size_t index) -> void
+	{
+		if (entries_.size() >= std::numeric_limits<std::uint32_t>::max() / 2u ||
+			codes_.size() + code.size() > std::numeric_limits<std::uint32_t>::max())
+			throw std::length_error{ "Too many instruments for a security registry" };
+
+		if (2uz * (entries_.size() + 1uz) > slots_.size())
+			_grow();
+
+		const auto entry = static_cast<std::uint32_t>(entries_.size());
+		const auto offset = codes_.size();
+		entries_.push_back(_entry{
+			hash,
+			static_cast<std::uint32_t>(offset),
+			static_cast<std::uint32_t>(code.size()),
+			static_cast<std::uint32_t>(index),
+			kind
+		});
+		try
+		{
+			codes_ += code;
+			(kind == _kind::bill ? bill_entries_ : bond_entries_).push_back(entry);
+		}
+		catch (...)
+		{
+			// the caller takes the instrument back out, so no trace of it should stay here either
+			codes_.resize(offset);
+			entries_.pop_back();
+			throw;
+		}
+
+		const auto mask = slots_.size() - 1uz;
+		auto slot = static_cast<std::size_t>(hash) & mask;
+		while (slots_[slot] != 0u)
+			slot = (slot + 1uz) & mask;
+
+		slots_[slot] = entry + 1u;
+	}
+
+	template<typename T>
+	auto security_registry<T>::_grow() -> void
+	{
+		auto slots = std::vector<std::uint32_t>(slots_.empty() ? 16uz : 2uz * slots_.size());
+
+		const auto mask = slots.size() - 1uz;
+		for (auto e = 0uz; e < entries_.size(); ++e)
+		{
+			auto slot = static_cast<std::size_t>(entries_[e].hash) & mask;
+			while (slots[slot] != 0u)
+				slot = (slot + 1uz) & mask;
+
+			slots[slot] = static_cast<std::uint32_t>(e + 1uz);
+		}
+
+		slots_ = std::move(slots);
+	}
+
+}
@@ -0,0 +1,187 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <security_registry.h>
+
+#include <ANBIMA.h>
+#include <bill.h>
+#include <bond.h>
+#include <quote.h>
+
+#include <resets_math.h>
+
+#include <static_data.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <ranges>
+#include <stdexcept>
+
+using namespace std;
+using namespace std::chrono;
+using namespace gregorian;
+using namespace fin_calendar;
+using namespace reset;
+using namespace gregorian::static_data;
+
+
+namespace debt_security
+{
+
+	static_assert(ranges::random_access_range<resolved_view<bill<double>>>);
+	static_assert(ranges::sized_range<resolved_view<bond<double>>>);
+
+
+	static auto _LTN(year_month_day maturity_date) -> bill<double>
+	{
+		return bill{ 2007y / July / 1d, maturity_date, locate_calendar("America/ANBIMA"s), 1'000.0 };
+	}
+
+	static auto _NTN_F() -> bond<double>
+	{
+		return bond{ 2008y / January / 1d, 2014y / January / 1d, SemiAnnual, 10.0, locate_calendar("America/ANBIMA"s), 1'000.0, 5u };
+	}
+
+
+	TEST(security_registry, intern1)
+	{
+		auto registry = security_registry{};
+
+		const auto LTN1 = registry.intern("BRSTNCLTN5B6"s, _LTN(2010y / July / 1d));
+		const auto LTN2 = registry.intern("BRSTNCLTN5C4"s, _LTN(2012y / January / 1d));
+		const auto NTN_F = registry.intern("BRSTNCNTF0G4"s, _NTN_F());
+
+		EXPECT_EQ(registry.size(), 3uz);
+		EXPECT_NE(LTN1, LTN2);
+		EXPECT_EQ(registry[LTN1].get_maturity_date(), 2010y / July / 1d);
+		EXPECT_EQ(registry[LTN2].get_maturity_date(), 2012y / January / 1d);
+		EXPECT_EQ(registry[NTN_F].get_maturity_date(), 2014y / January / 1d);
+
+		// the same code is the same instrument (the one registered first)
+		EXPECT_EQ(registry.intern("BRSTNCLTN5B6"s, _LTN(2020y / July / 1d)), LTN1);
+		EXPECT_EQ(registry.size(), 3uz);
+		EXPECT_EQ(registry[LTN1].get_maturity_date(), 2010y / July / 1d);
+
+		EXPECT_EQ(registry.get_bills().size(), 2uz);
+		EXPECT_EQ(registry.get_bonds().size(), 1uz);
+		EXPECT_EQ(registry.get_code(LTN2), "BRSTNCLTN5C4"s);
+		EXPECT_EQ(registry.get_code(NTN_F), "BRSTNCNTF0G4"s);
+	}
+
+	TEST(security_registry, intern2)
+	{
+		auto registry = security_registry{};
+
+		registry.intern("BRSTNCLTN5B6"s, _LTN(2010y / July / 1d));
+
+		EXPECT_THROW(registry.intern("BRSTNCLTN5B6"s, _NTN_F()), invalid_argument);
+		EXPECT_EQ(registry.size(), 1uz);
+		EXPECT_TRUE(registry.get_bonds().empty());
+	}
+
+	TEST(security_registry, find1)
+	{
+		auto registry = security_registry{};
+
+		const auto LTN = registry.intern("100000"s, _LTN(2010y / July / 1d)); // SELIC code
+		const auto NTN_F = registry.intern("950199"s, _NTN_F());
+
+		EXPECT_EQ(registry.find_bill("100000"s), LTN);
+		EXPECT_EQ(registry.find_bond("950199"s), NTN_F);
+
+		EXPECT_EQ(registry.find_bond("100000"s), nullopt); // not a bond
+		EXPECT_EQ(registry.find_bill("950199"s), nullopt);
+		EXPECT_EQ(registry.find_bill("100001"s), nullopt);
+		EXPECT_EQ(security_registry{}.find_bill("100000"s), nullopt);
+	}
+
+	TEST(security_registry, find2)
+	{
+		constexpr auto n = 10'000;
+
+		auto registry = security_registry{};
+
+		auto ids = vector<security_registry<double>::bill_id>{};
+		for (auto i = 0; i < n; ++i)
+			ids.push_back(registry.intern("BRSTN" + to_string(i), _LTN(year_month_day{ sys_days{ 2010y / July / 1d } + days{ i } })));
+
+		// ids stay the same as the index grows
+		for (auto i = 0; i < n; ++i)
+		{
+			const auto code = "BRSTN" + to_string(i);
+			ASSERT_EQ(registry.find_bill(code), ids[i]);
+			EXPECT_EQ(registry.get_code(ids[i]), code);
+			EXPECT_EQ(registry[ids[i]].get_maturity_date(), year_month_day{ sys_days{ 2010y / July / 1d } + days{ i } });
+		}
+
+		EXPECT_EQ(registry.find_bill("BRSTN" + to_string(n)), nullopt);
+	}
+
+	TEST(security_registry, price_batch1)
+	{
+		auto registry = security_registry{};
+		registry.reserve(2uz, 0uz);
+
+		const auto LTN1 = registry.intern("BRSTNCLTN5B6"s, _LTN(2010y / July / 1d));
+		const auto LTN2 = registry.intern("BRSTNCLTN5C4"s, _LTN(2012y / January / 1d));
+
+		// the same bills from several books
+		const auto ids = vector{ LTN1, LTN2, LTN1, LTN1 };
+		const auto yields = vector{ from_percent(14.36), from_percent(14.5), from_percent(14.36), from_percent(15.0) };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+		const auto quote = debt_security::quote{ 2008y / May / 21d, 1'000.0, 6u };
+
+		auto prices = vector<double>(ids.size());
+		ANBIMA.price_batch(yields, registry.resolve(ids), quote, prices);
+
+		EXPECT_EQ(prices[0], 753.315323);
+		for (auto i = 0uz; i < ids.size(); ++i)
+			EXPECT_EQ(prices[i], ANBIMA.price(yields[i], registry[ids[i]], quote));
+
+		auto wrong = vector<double>(1uz);
+		EXPECT_THROW(ANBIMA.price_batch(yields, registry.resolve(ids), quote, wrong), invalid_argument);
+	}
+
+	TEST(security_registry, price_batch2)
+	{
+		auto registry = security_registry{};
+
+		const auto NTN_F = registry.intern("BRSTNCNTF0G4"s, _NTN_F());
+
+		const auto ids = vector{ NTN_F, NTN_F };
+		const auto yield = from_percent(13.66);
+		const auto table = discount_table{ yield, 2'000 };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+		const auto quote = debt_security::quote{ 2008y / May / 21d, 1'000.0, 6u };
+
+		auto prices = vector<double>(ids.size());
+		ANBIMA.price_batch(table, registry.resolve(ids), quote, prices);
+
+		EXPECT_EQ(prices[0], ANBIMA.price(table, registry[NTN_F], quote));
+		EXPECT_EQ(prices[1], prices[0]);
+	}
+
+}
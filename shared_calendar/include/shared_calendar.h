@@ -0,0 +1,65 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+#include <calendar.h>
+
+
+namespace debt_security
+{
+
+	// immutable calendar which is shared between instruments rather than copied into each of them
+	using shared_calendar = std::shared_ptr<const gregorian::calendar>;
+
+
+	// returns the same shared_calendar for all equal calendars
+	// (so instruments built from copies of the same calendar still share a single one)
+	inline auto intern_calendar(const gregorian::calendar& cal) -> shared_calendar
+	{
+		static auto mutex = std::mutex{};
+		static auto calendars = std::vector<shared_calendar>{}; // we only expect a handful of calendars
+
+		const auto lock = std::lock_guard{ mutex };
+
+		// comparing addresses first is cheap and catches calendars which are already interned
+		auto it = std::ranges::find_if(calendars, [&](const auto& c) { return c.get() == &cal; });
+		if (it == calendars.end())
+			it = std::ranges::find_if(calendars, [&](const auto& c) { return *c == cal; });
+
+		if (it != calendars.end())
+			return *it;
+
+		return calendars.emplace_back(std::make_shared<const gregorian::calendar>(cal));
+	}
+
+	inline auto intern_calendar(const shared_calendar& cal) -> shared_calendar
+	{
+		return intern_calendar(*cal);
+	}
+
+}
@@ -0,0 +1,74 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <shared_calendar.h>
+
+#include <static_data.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <memory>
+
+using namespace std;
+using namespace gregorian;
+using namespace gregorian::static_data;
+
+
+namespace debt_security
+{
+
+	TEST(shared_calendar, intern_calendar1)
+	{
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+
+		const auto c1 = intern_calendar(calendar);
+		const auto c2 = intern_calendar(calendar);
+
+		EXPECT_EQ(c1, c2);
+		EXPECT_EQ(*c1, calendar);
+	}
+
+	TEST(shared_calendar, intern_calendar2)
+	{
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto copy = calendar;
+
+		const auto c1 = intern_calendar(calendar);
+		const auto c2 = intern_calendar(copy); // equal calendars are interned together
+
+		EXPECT_EQ(c1, c2);
+	}
+
+	TEST(shared_calendar, intern_calendar3)
+	{
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+
+		const auto c1 = intern_calendar(calendar);
+		const auto c2 = intern_calendar(make_shared<const gregorian::calendar>(calendar));
+		const auto c3 = intern_calendar(*c1); // already interned
+
+		EXPECT_EQ(c1, c2);
+		EXPECT_EQ(c1, c3);
+	}
+
+}
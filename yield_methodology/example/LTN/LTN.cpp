@@ -23,6 +23,7 @@
 #include <chrono>
 #include <iostream>
 #include <limits>
+#include <vector>
 
 #include <boost/multiprecision/cpp_dec_float.hpp>
 
@@ -31,9 +32,13 @@
 #include <static_data.h>
 
 #include <ANBIMA.h>
+#include <discount_table.h>
 #include <bill.h>
 #include <quote.h>
 
+#include <grid_scanner.h>
+#include <work_stealing_pool.h>
+
 using namespace std;
 using namespace std::chrono;
 using namespace boost::multiprecision;
@@ -60,20 +65,38 @@ int main()
 	const auto ym = ANBIMA<cpp_dec_float_50>{};
 
 	const auto issue_date = start_date;
+
+	auto bills = vector<bill<cpp_dec_float_50>>{};
+	bills.reserve(number_of_bills);
 	for (auto i = 0; i < number_of_bills; ++i)
 	{
 		const auto maturity_date = year_month_day{ sys_days{ issue_date } + days{ i + 1 } };
-		const auto b = bill<cpp_dec_float_50>{ issue_date, maturity_date, calendar, face };
+		bills.emplace_back(issue_date, maturity_date, calendar, face);
+	}
+
+	const auto grid = yield_grid{ std::move(bills), vector{ from_percent(yield) }, vector{ q } };
 
-		const auto y = from_percent(yield);
-		const auto price = ym.price(y, b, q);
+	// all bills are at the same yield, so we can use a table rather than a pow for each of them
+	// (there can not be more business days than calendar days)
+	const auto table = discount_table<cpp_dec_float_50>{ from_percent(yield), number_of_bills + 1 };
 
+	auto pool = work_stealing_pool{};
+
+	const auto prices = scan(
+		pool,
+		grid.size(),
+		[&](size_t i) { return ym.price(table, grid.get_instruments()[grid.point(i).maturity], q); },
+		table_reducer<cpp_dec_float_50>{}
+	);
+
+	for (auto i = 0uz; i < prices.size(); ++i)
+	{
 		cout
 			<< setprecision(numeric_limits<cpp_dec_float_50>::max_digits10)
 			<< "Issue date: " << issue_date
-			<< ", Maturity date: " << maturity_date
+			<< ", Maturity date: " << grid.get_instruments()[grid.point(i).maturity].get_maturity_date()
 			<< ", Yield: " << yield
-			<< ", Price: " << price
+			<< ", Price: " << prices[i]
 			<< endl;
 	}
 }
@@ -23,6 +23,7 @@
 #include <chrono>
 #include <iostream>
 #include <limits>
+#include <vector>
 #include <cmath>
 
 #include <boost/multiprecision/cpp_dec_float.hpp>
@@ -35,6 +36,9 @@
 #include <bill.h>
 #include <quote.h>
 
+#include <grid_scanner.h>
+#include <work_stealing_pool.h>
+
 using namespace std;
 using namespace std::chrono;
 using namespace boost::multiprecision;
@@ -67,26 +71,48 @@ int main()
 	const auto ym_dec = debt_security::ANBIMA<cpp_dec_float_50>{};
 	const auto ym_bin = debt_security::ANBIMA<double>{};
 
-	auto diff = 0.0;
+	auto yields_dec = vector<cpp_dec_float_50>{};
+	auto yields_bin = vector<double>{};
 	for (auto yield = min_yield; yield <= max_yield; yield += yield_step)
 	{
 		const auto yield_truncate = 4u;
 
-		const auto y_dec = from_percent(trunc_dp(yield, yield_truncate));
-		const auto p_dec = ym_dec.price(y_dec, b_dec, q_dec);
+		yields_dec.push_back(from_percent(trunc_dp(yield, yield_truncate)));
+		yields_bin.push_back(from_percent(trunc_dp(static_cast<double>(yield), yield_truncate))); // do we need to go via std::string?
+	}
 
-		const auto y_bin = from_percent(trunc_dp(static_cast<double>(yield), yield_truncate)); // do we need to go via std::string?
-		const auto p_bin = ym_bin.price(y_bin, b_bin, q_bin);
+	// one maturity and one settlement date, so the grids only vary the yield
+	const auto grid_dec = yield_grid{ vector{ b_dec }, std::move(yields_dec), vector{ q_dec } };
+	const auto grid_bin = yield_grid{ vector{ b_bin }, std::move(yields_bin), vector{ q_bin } };
 
-		const auto new_diff = abs(static_cast<double>(p_dec) - p_bin);
-		if(new_diff > diff)
-		{
-			diff = new_diff;
+	auto pool = work_stealing_pool{};
 
-			cout
-				<< setprecision(numeric_limits<cpp_dec_float_50>::max_digits10)
-				<< "New largest diff: " << diff << " for yield: " << yield
-				<< ", Price (decimal): " << p_dec << ", Price (binary): " << p_bin << endl;
-		}
+	const auto diff = scan_price_differences(pool, grid_dec, ym_dec, grid_bin, ym_bin, max_reducer<double>{});
+	if (diff.index)
+	{
+		cout
+			<< setprecision(numeric_limits<cpp_dec_float_50>::max_digits10)
+			<< "Largest diff: " << diff.value << " for yield: " << grid_dec.get_yields()[grid_dec.point(*diff.index).yield]
+			<< ", Price (decimal): " << grid_dec.price(ym_dec, *diff.index)
+			<< ", Price (binary): " << grid_bin.price(ym_bin, *diff.index) << endl;
 	}
+
+	auto counters = mixed_precision_counters{};
+
+	// price_mixed should always be the same as the decimal price
+	const auto mismatches = scan(
+		pool,
+		grid_dec.size(),
+		[&](size_t i)
+		{
+			const auto p = grid_dec.point(i);
+			const auto p_mix = ym_dec.price_mixed(grid_dec.get_yields()[p.yield], b_dec, q_dec, &counters);
+			return p_mix != grid_dec.price(ym_dec, i) ? 1 : 0;
+		},
+		sum_reducer<int>{}
+	);
+
+	cout
+		<< "Mixed precision: " << counters.fast << " from double, " << counters.slow << " recalculated in decimal, "
+		<< mismatches << " different from decimal" << endl;
 }
@@ -0,0 +1,136 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// prices an end of day quote file:
+// price_quotes <security master> <quotes> <prices> [workers]
+// where quotes has a header line and then rows of "instrument,settlement date,yield" - the instrument is its position in the security master
+// (as written by write_security_master) and the yield is in percent
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <variant>
+#include <fstream>
+#include <iostream>
+#include <charconv>
+#include <exception>
+#include <stdexcept>
+
+#include <resets_math.h>
+
+#include <static_data.h>
+
+#include <ANBIMA.h>
+#include <bill.h>
+#include <bond.h>
+#include <quote.h>
+
+#include <security_master.h>
+#include <pricing_pipeline.h>
+
+using namespace std;
+using namespace gregorian::static_data;
+using namespace reset;
+using namespace debt_security;
+
+
+using instrument = variant<bill<double>, bond<double>>;
+
+
+auto make_instruments(const security_master<double>& master) -> vector<instrument>
+{
+	auto instruments = vector<instrument>{};
+	instruments.reserve(master.size());
+	for (auto i = 0uz; i < master.size(); ++i)
+	{
+		const auto security = master[i];
+		if (security.get_kind() == security_kind::bill)
+			instruments.emplace_back(security.make_bill());
+		else
+			instruments.emplace_back(security.make_bond());
+	}
+
+	return instruments;
+}
+
+auto find_instrument(const vector<instrument>& instruments, string_view id) -> const instrument&
+{
+	auto i = 0uz;
+	const auto [end, error] = from_chars(id.data(), id.data() + id.size(), i);
+	if (error != errc{} || end != id.data() + id.size() || i >= instruments.size())
+		throw invalid_argument{ "Unknown instrument: " + string{ id } };
+
+	return instruments[i];
+}
+
+
+int main(int argc, char* argv[])
+{
+	if (argc < 4 || argc > 5)
+	{
+		cerr << "Usage: " << argv[0] << " <security master> <quotes> <prices> [workers]" << endl;
+		return 1;
+	}
+
+	try
+	{
+		const auto master = security_master<double>{ argv[1], locate_calendar };
+		const auto instruments = make_instruments(master); // calendars and flows are shared by all rows
+
+		const auto ym = ANBIMA<double>{};
+		const auto truncate = 6u;
+
+		const auto price = [&](const quote_row<double>& row)
+		{
+			return visit(
+				[&](const auto& i)
+				{
+					const auto q = quote<double>{ row.settlement_date, i.get_face(), truncate };
+					return ym.price(from_percent(row.yield), i, q);
+				},
+				find_instrument(instruments, row.instrument)
+			);
+		};
+
+		auto options = pipeline_options{ .header = true };
+		if (argc == 5)
+			options.workers = static_cast<unsigned int>(stoul(argv[4]));
+
+		auto in = ifstream{ argv[2], ios::binary };
+		if (!in)
+			throw runtime_error{ "Cannot open "s + argv[2] };
+
+		auto out = ofstream{ argv[3], ios::binary | ios::trunc };
+		if (!out)
+			throw runtime_error{ "Cannot open "s + argv[3] };
+
+		const auto statistics = price_quote_stream<double>(in, out, price, options);
+
+		cout << "Priced " << statistics.rows << " rows" << endl;
+	}
+	catch (const exception& e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+}
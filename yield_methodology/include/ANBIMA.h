@@ -22,9 +22,35 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <optional>
+#include <vector>
+#include <utility>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <ranges>
+#include <concepts>
+#include <type_traits>
+#include <stdexcept>
+
 #include <resets_math.h>
 
-#include <calculation_252.h>
+#include <period.h>
+#include <calendar.h>
+
+#include <cash_flow.h>
+
+#include <business_day_index.h>
+#include <discount_table.h>
+#include <discount_kernel.h>
+#include <flow_block.h>
 
 #include <bill.h>
 #include <bond.h>
@@ -34,12 +60,59 @@
 namespace debt_security
 {
 
+	// how often ANBIMA::price_mixed (or price_batch_vectorised) could do without T
+	struct mixed_precision_counters final
+	{
+		std::atomic<std::uint64_t> fast{ 0 };
+		std::atomic<std::uint64_t> slow{ 0 }; // recalculated in T, as double was too close to a truncation boundary (or nothing is truncated)
+	};
+
+
+	// durations and convexity are in years (of 252 business days) and are with respect to the annually compounded yield
+	template<typename T = double>
+	struct price_analytics final
+	{
+		T price; // as from price (so truncated if the quote truncates)
+		T macaulay_duration;
+		T modified_duration;
+		T dv01; // price change for a 1bp fall in the yield (before any truncation)
+		T convexity;
+	};
+
+
+	// everything which is quoted for a bond at once, worked out from the same lookup of the coupon period
+	template<typename T = double>
+	struct price_quotation final
+	{
+		T dirty_price; // as from price (so truncated if the quote truncates)
+		T accrued_interest; // share of the current coupon, pro rata by business days
+		T clean_price; // dirty price less accrued interest
+		T quotation; // clean price as a percentage of face (cotacao)
+	};
+
+	// decimal places each field of price_quotation is truncated to (the dirty price is truncated by the quote)
+	struct quotation_truncation final
+	{
+		std::optional<unsigned int> accrued_interest{};
+		std::optional<unsigned int> clean_price{};
+		std::optional<unsigned int> quotation{};
+	};
+
+
+	// bills, or bonds, we can price in a batch
+	template<typename R, typename T>
+	concept instrument_range =
+		std::ranges::sized_range<R> &&
+		(std::same_as<std::ranges::range_value_t<R>, bill<T>> || std::same_as<std::ranges::range_value_t<R>, bond<T>>);
+
+
 	template<typename T = double>
 	class ANBIMA final // better name?
 	{
 
 	public:
 
+		// only flows paid after the settlement date are part of the price (and of the yield, analytics and so on)
 		auto price(
 			const T& yield,
 			const bill<T>& bill,
@@ -57,6 +130,445 @@ namespace debt_security
 			const quote<T>& quote
 		) const -> T;
 
+		// the same as above at the yield of the table, but with a lookup rather than a pow for each flow
+		auto price(
+			const discount_table<T>& table,
+			const bill<T>& bill,
+			const quote<T>& quote
+		) const -> T;
+
+		auto price(
+			const discount_table<T>& table,
+			const bond<T>& bond,
+			const quote<T>& quote
+		) const -> T;
+
+		// flows which do not come from an instrument (for example from a security master),
+		// discounted the same way as the flows of a bond on the given calendar
+		auto price(
+			const T& yield,
+			const flow_block<T>& flows,
+			const gregorian::calendar& cal,
+			const quote<T>& quote
+		) const -> T;
+
+		// any random access range of cash flows (in any order, but each date is a separate flow),
+		// so also flows which are worked out on demand, as from bond_flow_view
+		template<std::ranges::random_access_range Flows>
+			requires std::same_as<std::ranges::range_value_t<Flows>, fin_calendar::cash_flow<T>>
+		auto price(
+			const T& yield,
+			const Flows& flows,
+			const gregorian::calendar& cal,
+			const quote<T>& quote
+		) const -> T;
+
+	public:
+
+		// prices[i] is the price of bills[i] at yields[i]
+		// (calendar lookups and settlement date conversion are done once per batch rather than once per instrument)
+		auto price_batch(
+			std::span<const T> yields,
+			std::span<const bill<T>> bills,
+			const quote<T>& quote,
+			std::span<T> prices
+		) const -> void;
+
+		auto price_batch(
+			std::span<const T> yields,
+			std::span<const bond<T>> bonds,
+			const quote<T>& quote,
+			std::span<T> prices
+		) const -> void;
+
+		// all instruments at the yield of the table
+		auto price_batch(
+			const discount_table<T>& table,
+			std::span<const bill<T>> bills,
+			const quote<T>& quote,
+			std::span<T> prices
+		) const -> void;
+
+		auto price_batch(
+			const discount_table<T>& table,
+			std::span<const bond<T>> bonds,
+			const quote<T>& quote,
+			std::span<T> prices
+		) const -> void;
+
+		// the same for instruments which are not next to each other (for example those of a security_registry, by id)
+		template<std::ranges::random_access_range Instruments>
+			requires instrument_range<Instruments, T>
+		auto price_batch(
+			std::span<const T> yields,
+			const Instruments& instruments,
+			const quote<T>& quote,
+			std::span<T> prices
+		) const -> void;
+
+		template<std::ranges::random_access_range Instruments>
+			requires instrument_range<Instruments, T>
+		auto price_batch(
+			const discount_table<T>& table,
+			const Instruments& instruments,
+			const quote<T>& quote,
+			std::span<T> prices
+		) const -> void;
+
+	public:
+
+		// prices[i] is the price of the instrument at yields[i] (for example the bids of an auction),
+		// with the flows and their year fractions worked out once rather than once per yield
+		auto price_at_yields(
+			std::span<const T> yields,
+			const bill<T>& bill,
+			const quote<T>& quote,
+			std::span<T> prices
+		) const -> void;
+
+		auto price_at_yields(
+			std::span<const T> yields,
+			const bond<T>& bond,
+			const quote<T>& quote,
+			std::span<T> prices
+		) const -> void;
+
+	public:
+
+		using discounted_flows = std::vector<std::pair<T, T>>; // amount and year fraction
+
+		// the flows which go into the price, in the order price adds them up, worked out once
+		// so the same instrument can be priced under many yields (for example in a stress test)
+		auto precompute_flows(
+			const bill<T>& bill,
+			const quote<T>& quote
+		) const -> discounted_flows;
+
+		auto precompute_flows(
+			const bond<T>& bond,
+			const quote<T>& quote
+		) const -> discounted_flows;
+
+		// the same as the price of the instrument the flows were worked out for
+		auto price(
+			const T& yield,
+			const discounted_flows& flows,
+			const quote<T>& quote
+		) const -> T;
+
+	public:
+
+		// the same result as price, but calculated in double together with a bound on its error,
+		// T is only used when the bound straddles a truncation boundary of the quote
+		auto price_mixed(
+			const T& yield,
+			const bill<T>& bill,
+			const quote<T>& quote,
+			mixed_precision_counters* counters = nullptr
+		) const -> T;
+
+		auto price_mixed(
+			const T& yield,
+			const bond<T>& bond,
+			const quote<T>& quote,
+			mixed_precision_counters* counters = nullptr
+		) const -> T;
+
+		// the same prices as price_batch, with the double prices of price_mixed, but with the discount factors
+		// of a whole chunk of instruments from the vectorised kernel of discount_kernel.h rather than a pow for each flow
+		// (so again T is only used for prices which are too close to a truncation boundary, or if the quote does not truncate)
+		auto price_batch_vectorised(
+			std::span<const T> yields,
+			std::span<const bill<T>> bills,
+			const quote<T>& quote,
+			std::span<T> prices,
+			mixed_precision_counters* counters = nullptr
+		) const -> void;
+
+		auto price_batch_vectorised(
+			std::span<const T> yields,
+			std::span<const bond<T>> bonds,
+			const quote<T>& quote,
+			std::span<T> prices,
+			mixed_precision_counters* counters = nullptr
+		) const -> void;
+
+	public:
+
+		// price and its sensitivities to the yield from a single pass over the flows
+		// (rather than repricing at bumped yields)
+		auto analytics(
+			const T& yield,
+			const bill<T>& bill,
+			const quote<T>& quote
+		) const -> price_analytics<T>;
+
+		auto analytics(
+			const T& yield,
+			const bond<T>& bond,
+			const quote<T>& quote
+		) const -> price_analytics<T>;
+
+	public:
+
+		// dirty and clean prices, accrued interest and cotacao from a single pass over the flows
+		// (a bill does not accrue, so its clean price is its price, and cotacao is on the face of the quote for both)
+		auto quotation(
+			const T& yield,
+			const bill<T>& bill,
+			const quote<T>& quote,
+			const quotation_truncation& truncation = quotation_truncation{}
+		) const -> price_quotation<T>;
+
+		auto quotation(
+			const T& yield,
+			const bond<T>& bond,
+			const quote<T>& quote,
+			const quotation_truncation& truncation = quotation_truncation{}
+		) const -> price_quotation<T>;
+
+	public:
+
+		// inverse of price: the yield which reprices to the given price under the quote
+		// (if the quote truncates prices, we aim at the middle of the truncation interval)
+		auto yield(
+			const T& price,
+			const bill<T>& bill,
+			const quote<T>& quote
+		) const -> T;
+
+		auto yield(
+			const T& price,
+			const bond<T>& bond,
+			const quote<T>& quote
+		) const -> T;
+
+	private:
+
+		// the flows which go into the price, in the order price adds them up
+		template<typename Instrument>
+		static auto _discounted_flows(
+			const Instrument& instrument,
+			const quote<T>& quote
+		) -> discounted_flows;
+
+		static auto _price(
+			const T& yield,
+			const discounted_flows& flows,
+			const quote<T>& quote
+		) -> T;
+
+		template<typename Instrument>
+		static auto _price_at_yields(
+			std::span<const T> yields,
+			const Instrument& instrument,
+			const quote<T>& quote,
+			std::span<T> prices
+		) -> void;
+
+		// dates we need business days for
+		static auto _period(
+			const bill<T>& bill,
+			const std::chrono::year_month_day& settlement_date
+		) -> gregorian::util::days_period;
+
+		static auto _period(
+			const bond<T>& bond,
+			const std::chrono::year_month_day& settlement_date
+		) -> gregorian::util::days_period;
+
+		static auto _period(
+			const flow_block<T>& flows,
+			const std::chrono::year_month_day& settlement_date
+		) -> gregorian::util::days_period;
+
+		static auto _business_days(
+			const business_day_index& index,
+			std::int32_t start,
+			std::int32_t end
+		) -> std::int32_t; // dates as serial days
+
+		// the loop every price goes through: flow(i) gives the amount and the payment day (as a serial day) of the i-th flow,
+		// and discount(amount, business days) gives its present value
+		template<typename Flow, typename Discount>
+		static auto _present_value(
+			std::size_t size,
+			Flow&& flow,
+			const business_day_index& index,
+			std::int32_t settlement,
+			Discount&& discount
+		) -> T;
+
+		template<typename Discount>
+		static auto _price(
+			const bill<T>& bill,
+			const quote<T>& quote,
+			const business_day_index& index,
+			std::int32_t settlement,
+			Discount&& discount
+		) -> T;
+
+		template<typename Discount>
+		static auto _price(
+			const bond<T>& bond,
+			const quote<T>& quote,
+			const business_day_index& index,
+			std::int32_t settlement,
+			Discount&& discount
+		) -> T;
+
+		template<typename Discount>
+		static auto _price(
+			const flow_block<T>& flows,
+			const quote<T>& quote,
+			const business_day_index& index,
+			std::int32_t settlement,
+			Discount&& discount
+		) -> T;
+
+		// discount(i, amount, business days) gives the present value of a single flow of the i-th instrument
+		template<typename Instruments, typename Discount>
+		static auto _price_batch(
+			const Instruments& instruments,
+			const quote<T>& quote,
+			std::span<T> prices,
+			Discount&& discount
+		) -> void;
+
+		// all dates the instruments of a batch need business days for
+		template<typename Instruments>
+		static auto _batch_period(
+			const Instruments& instruments,
+			const std::chrono::year_month_day& settlement_date
+		) -> gregorian::util::days_period;
+
+		static auto _truncate(
+			const T& price,
+			const quote<T>& quote
+		) -> T;
+
+		static auto _truncate(
+			const T& value,
+			const std::optional<unsigned int>& truncate
+		) -> T;
+
+		static auto _quotation(
+			const T& dirty_price,
+			const T& accrued_interest,
+			const T& face,
+			const quotation_truncation& truncation
+		) -> price_quotation<T>;
+
+		// what _truncate gives for any price in (units, units + 1) * 10^-truncate
+		static auto _truncate_units(
+			std::int64_t units,
+			const quote<T>& quote
+		) -> T;
+
+		// f(amount, payment day) for each flow which goes into the price (days are serial days)
+		template<typename F>
+		static auto _for_each_flow(
+			const bill<T>& bill,
+			const quote<T>& quote,
+			F&& f
+		) -> void;
+
+		template<typename F>
+		static auto _for_each_flow(
+			const bond<T>& bond,
+			const quote<T>& quote,
+			F&& f
+		) -> void;
+
+		template<typename Instrument>
+		static auto _analytics(
+			const T& yield,
+			const Instrument& instrument,
+			const quote<T>& quote
+		) -> price_analytics<T>;
+
+		template<typename Instrument>
+		auto _price_mixed(
+			const T& yield,
+			const Instrument& instrument,
+			const quote<T>& quote,
+			mixed_precision_counters* counters
+		) const -> T;
+
+		template<typename Instrument>
+		auto _price_batch_vectorised(
+			std::span<const T> yields,
+			std::span<const Instrument> instruments,
+			const quote<T>& quote,
+			std::span<T> prices,
+			mixed_precision_counters* counters
+		) const -> void;
+
+		// price in double with a bound on how far it can be from the price in T
+		class _double_price final
+		{
+
+		public:
+
+			explicit _double_price(double yield, double reference_epsilon) noexcept;
+
+		public:
+
+			auto add(double amount, std::int32_t business_days) noexcept -> void;
+
+			// with a discount factor from discount_factors (for log_base and year_fraction below)
+			auto add(double amount, double year_fraction, double discount_factor) noexcept -> void;
+
+			// the truncated price in units of 10^-truncate, unless the bound straddles a boundary
+			auto truncated(unsigned int truncate) const noexcept -> std::optional<std::int64_t>;
+
+		public:
+
+			auto get_log_base() const noexcept -> double;
+
+			// the same truncation as year_fraction_252 for decimals, which is exact in double up to the final division
+			static auto year_fraction(std::int32_t business_days) noexcept -> double;
+
+		private:
+
+			double yield_;
+			double base_;
+			double log_base_;
+			double reference_epsilon_;
+
+			double price_{ 0.0 };
+			double magnitude_{ 0.0 }; // sum of absolute values of the discounted flows
+			double error_{ 0.0 };
+			std::size_t flows_{ 0uz };
+
+		};
+
+		// instruments in a batch usually share the calendar, so we only look up the index when it changes
+		class _batch_index final
+		{
+
+		public:
+
+			explicit _batch_index(gregorian::util::days_period period) noexcept;
+
+		public:
+
+			auto get(const gregorian::calendar& cal) -> const business_day_index&;
+
+		private:
+
+			gregorian::util::days_period period_;
+			const gregorian::calendar* cal_{ nullptr };
+			std::shared_ptr<const business_day_index> index_{};
+
+		};
+
+		static auto _solve_yield(
+			const T& price,
+			const discounted_flows& flows,
+			const quote<T>& quote
+		) -> T;
+
 	};
 
 
@@ -67,21 +579,21 @@ namespace debt_security
 		const quote<T>& quote
 	) const -> T
 	{
-		const auto cf = bill.cash_flow();
-		const auto dc = fin_calendar::calculation_252{ bill.get_calendar() };
-		/*const*/ auto yf = dc.fraction(quote.get_settlement_date(), cf.get_payment_date());
-		// we should probably note that end date would give the same year fraction as the end date is not included in the period
-		// and hence unadjusted end date, or following adjusted end date would give the same number of business days
+		const auto& settlement_date = quote.get_settlement_date();
+		const auto index = locate_business_day_index(bill.get_calendar(), _period(bill, settlement_date));
 
-		yf = reset::trunc_dp(yf, 14u); // ok to hard code this?
+		const auto one = T{ 1 };
 
-		const auto price = quote.get_face() / pow(T{ 1 } + yield, yf); // should we use amount from the cashflow?
-
-		const auto& truncate = quote.get_truncate(); // should this also be hard coded?
-		if (truncate)
-			return reset::trunc_dp(price, *truncate);
-		else
-			return price;
+		return _price(
+			bill,
+			quote,
+			*index,
+			to_serial_day(settlement_date),
+			[&](const T& amount, std::int32_t business_days)
+			{
+				return T{ amount / pow(one + yield, year_fraction_252<T>(business_days)) };
+			}
+		);
 	}
 
 
@@ -92,30 +604,1259 @@ namespace debt_security
 		const quote<T>& quote
 	) const -> T
 	{
-		const auto cfs = bond.cash_flow();
+		const auto& settlement_date = quote.get_settlement_date();
+		const auto index = locate_business_day_index(bond.get_calendar(), _period(bond, settlement_date));
 
-		const auto dc = fin_calendar::calculation_252{ bond.get_calendar() };
+		const auto one = T{ 1 };
 
-		auto price = T{ 0 };
-		for (const auto& cf : cfs)
-		{
-			/*const*/ auto yf = dc.fraction(quote.get_settlement_date(), cf.get_payment_date());
-			// we should probably note that end date would give the same year fraction as the end date is not included in the period
-			// and hence unadjusted end date, or following adjusted end date would give the same number of business days
+		return _price(
+			bond,
+			quote,
+			*index,
+			to_serial_day(settlement_date),
+			[&](const T& amount, std::int32_t business_days)
+			{
+				return T{ amount / pow(one + yield, year_fraction_252<T>(business_days)) };
+			}
+		);
 
-			yf = reset::trunc_dp(yf, 14u); // ok to hard code this?
+		// do we also need a notion of the currency? (to capture "Financial value" truncation)
+	}
 
-			price += cf.get_amount() / pow(T{ 1 } + yield, yf); // we should sum up the amounts on the same date first
-			// there is also a rounding of each discounted value
+
+	template<typename T>
+	auto ANBIMA<T>::price(
+		const discount_table<T>& table,
+		const bill<T>& bill,
+		const quote<T>& quote
+	) const -> T
+	{
+		const auto& settlement_date = quote.get_settlement_date();
+		const auto index = locate_business_day_index(bill.get_calendar(), _period(bill, settlement_date));
+
+		return _price(
+			bill,
+			quote,
+			*index,
+			to_serial_day(settlement_date),
+			[&](const T& amount, std::int32_t business_days)
+			{
+				return T{ amount / table.compounding_factor(business_days) };
+			}
+		);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::price(
+		const discount_table<T>& table,
+		const bond<T>& bond,
+		const quote<T>& quote
+	) const -> T
+	{
+		const auto& settlement_date = quote.get_settlement_date();
+		const auto index = locate_business_day_index(bond.get_calendar(), _period(bond, settlement_date));
+
+		return _price(
+			bond,
+			quote,
+			*index,
+			to_serial_day(settlement_date),
+			[&](const T& amount, std::int32_t business_days)
+			{
+				return T{ amount / table.compounding_factor(business_days) };
+			}
+		);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::price(
+		const T& yield,
+		const flow_block<T>& flows,
+		const gregorian::calendar& cal,
+		const quote<T>& quote
+	) const -> T
+	{
+		const auto& settlement_date = quote.get_settlement_date();
+		const auto index = locate_business_day_index(cal, _period(flows, settlement_date));
+
+		const auto one = T{ 1 };
+
+		return _price(
+			flows,
+			quote,
+			*index,
+			to_serial_day(settlement_date),
+			[&](const T& amount, std::int32_t business_days)
+			{
+				return T{ amount / pow(one + yield, year_fraction_252<T>(business_days)) };
+			}
+		);
+	}
+
+
+	template<typename T>
+	template<std::ranges::random_access_range Flows>
+		requires std::same_as<std::ranges::range_value_t<Flows>, fin_calendar::cash_flow<T>>
+	auto ANBIMA<T>::price(
+		const T& yield,
+		const Flows& flows,
+		const gregorian::calendar& cal,
+		const quote<T>& quote
+	) const -> T
+	{
+		const auto& settlement_date = quote.get_settlement_date();
+
+		auto from = settlement_date;
+		auto until = settlement_date;
+		for (const auto& flow : flows)
+		{
+			from = std::min(from, flow.get_payment_date());
+			until = std::max(until, flow.get_payment_date());
 		}
 
-		const auto& truncate = quote.get_truncate(); // should this also be hard coded?
-		if (truncate)
-			return reset::trunc_dp(price, *truncate);
-		else
-			return price;
+		const auto index = locate_business_day_index(cal, gregorian::util::days_period{ from, until });
 
-		// do we also need a notion of the currency? (to capture "Financial value" truncation)
+		const auto first = std::ranges::begin(flows);
+
+		// flows worked out on demand are returned by value, so we cannot refer to their amounts
+		using amount = std::conditional_t<std::is_lvalue_reference_v<std::ranges::range_reference_t<const Flows>>, const T&, T>;
+
+		const auto one = T{ 1 };
+
+		const auto price = _present_value(
+			static_cast<std::size_t>(std::ranges::distance(flows)),
+			[&](std::size_t i)
+			{
+				decltype(auto) flow = first[static_cast<std::ranges::range_difference_t<const Flows>>(i)];
+				return std::tuple<amount, std::int32_t>{ flow.get_amount(), to_serial_day(flow.get_payment_date()) };
+			},
+			*index,
+			to_serial_day(settlement_date),
+			[&](const T& amount, std::int32_t business_days)
+			{
+				return T{ amount / pow(one + yield, year_fraction_252<T>(business_days)) };
+			}
+		);
+
+		return _truncate(price, quote);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::price_batch(
+		std::span<const T> yields,
+		std::span<const bill<T>> bills,
+		const quote<T>& quote,
+		std::span<T> prices
+	) const -> void
+	{
+		if (yields.size() != bills.size())
+			throw std::invalid_argument{ "Yields and bills must have the same size" };
+
+		const auto one = T{ 1 };
+
+		_price_batch(
+			bills,
+			quote,
+			prices,
+			[&](std::size_t i, const T& amount, std::int32_t business_days)
+			{
+				return T{ amount / pow(one + yields[i], year_fraction_252<T>(business_days)) };
+			}
+		);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::price_batch(
+		std::span<const T> yields,
+		std::span<const bond<T>> bonds,
+		const quote<T>& quote,
+		std::span<T> prices
+	) const -> void
+	{
+		if (yields.size() != bonds.size())
+			throw std::invalid_argument{ "Yields and bonds must have the same size" };
+
+		const auto one = T{ 1 };
+
+		_price_batch(
+			bonds,
+			quote,
+			prices,
+			[&](std::size_t i, const T& amount, std::int32_t business_days)
+			{
+				return T{ amount / pow(one + yields[i], year_fraction_252<T>(business_days)) };
+			}
+		);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::price_batch(
+		const discount_table<T>& table,
+		std::span<const bill<T>> bills,
+		const quote<T>& quote,
+		std::span<T> prices
+	) const -> void
+	{
+		_price_batch(
+			bills,
+			quote,
+			prices,
+			[&](std::size_t, const T& amount, std::int32_t business_days)
+			{
+				return T{ amount / table.compounding_factor(business_days) };
+			}
+		);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::price_batch(
+		const discount_table<T>& table,
+		std::span<const bond<T>> bonds,
+		const quote<T>& quote,
+		std::span<T> prices
+	) const -> void
+	{
+		_price_batch(
+			bonds,
+			quote,
+			prices,
+			[&](std::size_t, const T& amount, std::int32_t business_days)
+			{
+				return T{ amount / table.compounding_factor(business_days) };
+			}
+		);
+	}
+
+
+	template<typename T>
+	template<std::ranges::random_access_range Instruments>
+		requires instrument_range<Instruments, T>
+	auto ANBIMA<T>::price_batch(
+		std::span<const T> yields,
+		const Instruments& instruments,
+		const quote<T>& quote,
+		std::span<T> prices
+	) const -> void
+	{
+		if (yields.size() != std::ranges::size(instruments))
+			throw std::invalid_argument{ "Yields and instruments must have the same size" };
+
+		const auto one = T{ 1 };
+
+		_price_batch(
+			instruments,
+			quote,
+			prices,
+			[&](std::size_t i, const T& amount, std::int32_t business_days)
+			{
+				return T{ amount / pow(one + yields[i], year_fraction_252<T>(business_days)) };
+			}
+		);
+	}
+
+
+	template<typename T>
+	template<std::ranges::random_access_range Instruments>
+		requires instrument_range<Instruments, T>
+	auto ANBIMA<T>::price_batch(
+		const discount_table<T>& table,
+		const Instruments& instruments,
+		const quote<T>& quote,
+		std::span<T> prices
+	) const -> void
+	{
+		_price_batch(
+			instruments,
+			quote,
+			prices,
+			[&](std::size_t, const T& amount, std::int32_t business_days)
+			{
+				return T{ amount / table.compounding_factor(business_days) };
+			}
+		);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::price_at_yields(
+		std::span<const T> yields,
+		const bill<T>& bill,
+		const quote<T>& quote,
+		std::span<T> prices
+	) const -> void
+	{
+		_price_at_yields(yields, bill, quote, prices);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::price_at_yields(
+		std::span<const T> yields,
+		const bond<T>& bond,
+		const quote<T>& quote,
+		std::span<T> prices
+	) const -> void
+	{
+		_price_at_yields(yields, bond, quote, prices);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::precompute_flows(
+		const bill<T>& bill,
+		const quote<T>& quote
+	) const -> discounted_flows
+	{
+		return _discounted_flows(bill, quote);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::precompute_flows(
+		const bond<T>& bond,
+		const quote<T>& quote
+	) const -> discounted_flows
+	{
+		return _discounted_flows(bond, quote);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::price(
+		const T& yield,
+		const discounted_flows& flows,
+		const quote<T>& quote
+	) const -> T
+	{
+		return _price(yield, flows, quote);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::price_mixed(
+		const T& yield,
+		const bill<T>& bill,
+		const quote<T>& quote,
+		mixed_precision_counters* counters
+	) const -> T
+	{
+		return _price_mixed(yield, bill, quote, counters);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::price_mixed(
+		const T& yield,
+		const bond<T>& bond,
+		const quote<T>& quote,
+		mixed_precision_counters* counters
+	) const -> T
+	{
+		return _price_mixed(yield, bond, quote, counters);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::price_batch_vectorised(
+		std::span<const T> yields,
+		std::span<const bill<T>> bills,
+		const quote<T>& quote,
+		std::span<T> prices,
+		mixed_precision_counters* counters
+	) const -> void
+	{
+		if (yields.size() != bills.size())
+			throw std::invalid_argument{ "Yields and bills must have the same size" };
+
+		_price_batch_vectorised(yields, bills, quote, prices, counters);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::price_batch_vectorised(
+		std::span<const T> yields,
+		std::span<const bond<T>> bonds,
+		const quote<T>& quote,
+		std::span<T> prices,
+		mixed_precision_counters* counters
+	) const -> void
+	{
+		if (yields.size() != bonds.size())
+			throw std::invalid_argument{ "Yields and bonds must have the same size" };
+
+		_price_batch_vectorised(yields, bonds, quote, prices, counters);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::analytics(
+		const T& yield,
+		const bill<T>& bill,
+		const quote<T>& quote
+	) const -> price_analytics<T>
+	{
+		return _analytics(yield, bill, quote);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::analytics(
+		const T& yield,
+		const bond<T>& bond,
+		const quote<T>& quote
+	) const -> price_analytics<T>
+	{
+		return _analytics(yield, bond, quote);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::quotation(
+		const T& yield,
+		const bill<T>& bill,
+		const quote<T>& quote,
+		const quotation_truncation& truncation
+	) const -> price_quotation<T>
+	{
+		return _quotation(price(yield, bill, quote), T{ 0 }, quote.get_face(), truncation); // as in _price, the quote gives the face
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::quotation(
+		const T& yield,
+		const bond<T>& bond,
+		const quote<T>& quote,
+		const quotation_truncation& truncation
+	) const -> price_quotation<T>
+	{
+		const auto& settlement_date = quote.get_settlement_date();
+		const auto& block = bond.flow_block();
+		const auto payment_days = block.get_payment_days();
+		const auto amounts = block.get_amounts();
+
+		const auto settlement = to_serial_day(settlement_date);
+
+		// the coupon period settlement falls into: flows paid on the settlement date have already gone
+		const auto next = static_cast<std::size_t>(std::ranges::upper_bound(payment_days, settlement) - payment_days.begin());
+		if (next == block.size())
+			throw std::domain_error{ "No flows after the settlement date" };
+
+		const auto& issue_date = bond.get_issue_date();
+		const auto previous = next == 0uz ? to_serial_day(issue_date) : payment_days[next - 1uz];
+
+		const auto period = _period(block, settlement_date);
+		const auto index = locate_business_day_index(
+			bond.get_calendar(),
+			gregorian::util::days_period{ std::min(period.get_from(), issue_date), period.get_until() }
+		);
+
+		const auto one = T{ 1 };
+
+		auto days_to_next = std::optional<std::int32_t>{}; // counted by the pricing loop anyway
+		const auto dirty_price = _present_value(
+			block.size() - next,
+			[&](std::size_t i)
+			{
+				return std::tuple<const T&, std::int32_t>{ amounts[next + i], payment_days[next + i] };
+			},
+			*index,
+			settlement,
+			[&](const T& amount, std::int32_t business_days)
+			{
+				if (!days_to_next)
+					days_to_next = business_days;
+
+				return T{ amount / pow(one + yield, year_fraction_252<T>(business_days)) }; // exactly as in price
+			}
+		);
+
+		// the final flow also pays the principal
+		const auto coupon = next + 1uz == block.size() ? T{ amounts[next] - bond.get_face() } : amounts[next];
+
+		const auto days_accrued = _business_days(*index, previous, settlement);
+		const auto days_in_period = days_accrued + *days_to_next;
+		const auto accrued_interest = days_in_period == 0 ?
+			T{ 0 } :
+			T{ coupon * static_cast<T>(days_accrued) / static_cast<T>(days_in_period) };
+
+		return _quotation(_truncate(dirty_price, quote), accrued_interest, quote.get_face(), truncation); // as for a bill
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::yield(
+		const T& price,
+		const bill<T>& bill,
+		const quote<T>& quote
+	) const -> T
+	{
+		return _solve_yield(price, _discounted_flows(bill, quote), quote);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::yield(
+		const T& price,
+		const bond<T>& bond,
+		const quote<T>& quote
+	) const -> T
+	{
+		return _solve_yield(price, _discounted_flows(bond, quote), quote);
+	}
+
+
+	template<typename T>
+	template<typename Instrument>
+	auto ANBIMA<T>::_discounted_flows(
+		const Instrument& instrument,
+		const quote<T>& quote
+	) -> discounted_flows
+	{
+		const auto& settlement_date = quote.get_settlement_date();
+		const auto index = locate_business_day_index(instrument.get_calendar(), _period(instrument, settlement_date));
+
+		const auto settlement = to_serial_day(settlement_date);
+
+		auto flows = discounted_flows{};
+		_for_each_flow(
+			instrument,
+			quote,
+			[&](const T& amount, std::int32_t payment_day)
+			{
+				flows.emplace_back(amount, year_fraction_252<T>(_business_days(*index, settlement, payment_day)));
+			}
+		);
+
+		return flows;
+	}
+
+
+	template<typename T>
+	template<typename Instrument>
+	auto ANBIMA<T>::_price_at_yields(
+		std::span<const T> yields,
+		const Instrument& instrument,
+		const quote<T>& quote,
+		std::span<T> prices
+	) -> void
+	{
+		if (prices.size() != yields.size())
+			throw std::invalid_argument{ "Yields and prices must have the same size" };
+
+		const auto flows = _discounted_flows(instrument, quote);
+
+		for (auto i = 0uz; i < yields.size(); ++i)
+			prices[i] = _price(yields[i], flows, quote);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::_price(
+		const T& yield,
+		const discounted_flows& flows,
+		const quote<T>& quote
+	) -> T
+	{
+		const auto one = T{ 1 };
+		const auto base = T{ one + yield };
+
+		auto price = T{ 0 };
+		for (const auto& [amount, yf] : flows)
+			price += T{ amount / pow(base, yf) }; // exactly as in price
+
+		return _truncate(price, quote);
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::_period(
+		const bill<T>& bill,
+		const std::chrono::year_month_day& settlement_date
+	) -> gregorian::util::days_period
+	{
+		const auto& payment_date = bill.cash_flow().get_payment_date();
+
+		return gregorian::util::days_period{
+			std::min(settlement_date, payment_date),
+			std::max(settlement_date, payment_date)
+		};
+	}
+
+	template<typename T>
+	auto ANBIMA<T>::_period(
+		const bond<T>& bond,
+		const std::chrono::year_month_day& settlement_date
+	) -> gregorian::util::days_period
+	{
+		return _period(bond.flow_block(), settlement_date);
+	}
+
+	template<typename T>
+	auto ANBIMA<T>::_period(
+		const flow_block<T>& flows,
+		const std::chrono::year_month_day& settlement_date
+	) -> gregorian::util::days_period
+	{
+		const auto payment_days = flows.get_payment_days();
+		if (payment_days.empty())
+			return gregorian::util::days_period{ settlement_date, settlement_date };
+
+		// payment days are sorted
+		return gregorian::util::days_period{
+			std::min(settlement_date, from_serial_day(payment_days.front())),
+			std::max(settlement_date, from_serial_day(payment_days.back()))
+		};
+	}
+
+
+	// this is what fin_calendar::calculation_252 counts, but via the index
+	template<typename T>
+	auto ANBIMA<T>::_business_days(
+		const business_day_index& index,
+		std::int32_t start,
+		std::int32_t end
+	) -> std::int32_t
+	{
+		return index.business_days(start, end);
+		// we should probably note that end date would give the same year fraction as the end date is not included in the period
+		// and hence unadjusted end date, or following adjusted end date would give the same number of business days
+	}
+
+
+	template<typename T>
+	template<typename Flow, typename Discount>
+	auto ANBIMA<T>::_present_value(
+		std::size_t size,
+		Flow&& flow,
+		const business_day_index& index,
+		std::int32_t settlement,
+		Discount&& discount
+	) -> T
+	{
+		auto price = T{ 0 };
+		for (auto i = 0uz; i < size; ++i)
+		{
+			const auto [amount, payment_day] = flow(i);
+			if (payment_day <= settlement) // already paid, so not part of the price
+				continue;
+
+			price += discount(amount, _business_days(index, settlement, payment_day));
+			// there is also a rounding of each discounted value
+		}
+
+		return price;
+	}
+
+
+	template<typename T>
+	template<typename Discount>
+	auto ANBIMA<T>::_price(
+		const bill<T>& bill,
+		const quote<T>& quote,
+		const business_day_index& index,
+		std::int32_t settlement,
+		Discount&& discount
+	) -> T
+	{
+		const auto payment_day = bill.flow_block().get_payment_days().front();
+
+		const auto price = _present_value(
+			1uz,
+			[&](std::size_t)
+			{
+				return std::tuple<const T&, std::int32_t>{ quote.get_face(), payment_day }; // should we use amount from the cashflow?
+			},
+			index,
+			settlement,
+			std::forward<Discount>(discount)
+		);
+
+		return _truncate(price, quote);
+	}
+
+	template<typename T>
+	template<typename Discount>
+	auto ANBIMA<T>::_price(
+		const bond<T>& bond,
+		const quote<T>& quote,
+		const business_day_index& index,
+		std::int32_t settlement,
+		Discount&& discount
+	) -> T
+	{
+		return _price(bond.flow_block(), quote, index, settlement, std::forward<Discount>(discount));
+	}
+
+	template<typename T>
+	template<typename Discount>
+	auto ANBIMA<T>::_price(
+		const flow_block<T>& flows,
+		const quote<T>& quote,
+		const business_day_index& index,
+		std::int32_t settlement,
+		Discount&& discount
+	) -> T
+	{
+		const auto payment_days = flows.get_payment_days();
+		const auto amounts = flows.get_amounts();
+
+		const auto price = _present_value(
+			flows.size(),
+			[&](std::size_t i)
+			{
+				return std::tuple<const T&, std::int32_t>{ amounts[i], payment_days[i] };
+			},
+			index,
+			settlement,
+			std::forward<Discount>(discount)
+		);
+
+		return _truncate(price, quote);
+	}
+
+
+	template<typename T>
+	template<typename Instruments, typename Discount>
+	auto ANBIMA<T>::_price_batch(
+		const Instruments& instruments,
+		const quote<T>& quote,
+		std::span<T> prices,
+		Discount&& discount
+	) -> void
+	{
+		if (prices.size() != std::ranges::size(instruments))
+			throw std::invalid_argument{ "Instruments and prices must have the same size" };
+
+		const auto& settlement_date = quote.get_settlement_date();
+
+		auto index = _batch_index{ _batch_period(instruments, settlement_date) };
+
+		const auto settlement = to_serial_day(settlement_date);
+
+		auto i = 0uz;
+		for (const auto& instrument : instruments)
+		{
+			prices[i] = _price(
+				instrument,
+				quote,
+				index.get(instrument.get_calendar()),
+				settlement,
+				[&](const T& amount, std::int32_t business_days)
+				{
+					return discount(i, amount, business_days);
+				}
+			);
+			++i;
+		}
+	}
+
+
+	template<typename T>
+	template<typename Instruments>
+	auto ANBIMA<T>::_batch_period(
+		const Instruments& instruments,
+		const std::chrono::year_month_day& settlement_date
+	) -> gregorian::util::days_period
+	{
+		auto from = settlement_date;
+		auto until = settlement_date;
+		for (const auto& instrument : instruments)
+		{
+			const auto period = _period(instrument, settlement_date); // flows are cached, so this is the only time they are built
+			from = std::min(from, period.get_from());
+			until = std::max(until, period.get_until());
+		}
+
+		return gregorian::util::days_period{ from, until };
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::_truncate(
+		const T& price,
+		const quote<T>& quote
+	) -> T
+	{
+		return _truncate(price, quote.get_truncate()); // should this also be hard coded?
+	}
+
+	template<typename T>
+	auto ANBIMA<T>::_truncate(
+		const T& value,
+		const std::optional<unsigned int>& truncate
+	) -> T
+	{
+		if (truncate)
+			return reset::trunc_dp(value, *truncate);
+		else
+			return value;
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::_quotation(
+		const T& dirty_price,
+		const T& accrued_interest,
+		const T& face,
+		const quotation_truncation& truncation
+	) -> price_quotation<T>
+	{
+		const auto accrued = _truncate(accrued_interest, truncation.accrued_interest);
+		const auto clean_price = _truncate(T{ dirty_price - accrued }, truncation.clean_price); // from the fields as they are quoted
+		const auto quotation = _truncate(T{ clean_price / face * T{ 100 } }, truncation.quotation);
+
+		return price_quotation<T>{ dirty_price, accrued, clean_price, quotation };
+	}
+
+
+	template<typename T>
+	auto ANBIMA<T>::_truncate_units(
+		std::int64_t units,
+		const quote<T>& quote
+	) -> T
+	{
+		using std::pow;
+
+		// every price in (units, units + 1) * 10^-truncate truncates the same way,
+		// so the middle of it goes through the usual truncation to get exactly what price would return
+		const auto middle = T{
+			static_cast<T>(2 * units + 1) / (T{ 2 } * pow(T{ 10 }, static_cast<int>(*quote.get_truncate())))
+		};
+
+		return _truncate(middle, quote);
+	}
+
+
+	template<typename T>
+	template<typename F>
+	auto ANBIMA<T>::_for_each_flow(
+		const bill<T>& bill,
+		const quote<T>& quote,
+		F&& f
+	) -> void
+	{
+		const auto payment_day = bill.flow_block().get_payment_days().front();
+		if (payment_day > to_serial_day(quote.get_settlement_date())) // as in _present_value
+			f(quote.get_face(), payment_day); // as in _price
+	}
+
+	template<typename T>
+	template<typename F>
+	auto ANBIMA<T>::_for_each_flow(
+		const bond<T>& bond,
+		const quote<T>& quote,
+		F&& f
+	) -> void
+	{
+		const auto& block = bond.flow_block();
+		const auto payment_days = block.get_payment_days();
+		const auto amounts = block.get_amounts();
+
+		// as in _present_value, flows paid on or before settlement are gone
+		const auto first = std::ranges::upper_bound(payment_days, to_serial_day(quote.get_settlement_date())) - payment_days.begin();
+		for (auto i = static_cast<std::size_t>(first); i < block.size(); ++i)
+			f(amounts[i], payment_days[i]);
+	}
+
+
+	// with v = a / (1 + y)^t for each flow and P = sum(v):
+	// dP/dy = -sum(t * v) / (1 + y) and d2P/dy2 = sum(t * (t + 1) * v) / (1 + y)^2
+	template<typename T>
+	template<typename Instrument>
+	auto ANBIMA<T>::_analytics(
+		const T& yield,
+		const Instrument& instrument,
+		const quote<T>& quote
+	) -> price_analytics<T>
+	{
+		const auto& settlement_date = quote.get_settlement_date();
+		const auto index = locate_business_day_index(instrument.get_calendar(), _period(instrument, settlement_date));
+
+		const auto settlement = to_serial_day(settlement_date);
+
+		const auto one = T{ 1 };
+		const auto base = T{ one + yield };
+
+		auto pv = T{ 0 };
+		auto time_weighted = T{ 0 }; // sum(t * v)
+		auto convexity_weighted = T{ 0 }; // sum(t * (t + 1) * v)
+		_for_each_flow(
+			instrument,
+			quote,
+			[&](const T& amount, std::int32_t payment_day)
+			{
+				const auto yf = year_fraction_252<T>(_business_days(*index, settlement, payment_day));
+				const auto v = T{ amount / pow(base, yf) }; // exactly as in price
+
+				pv += v;
+				time_weighted += yf * v;
+				convexity_weighted += yf * (yf + one) * v;
+			}
+		);
+
+		if (pv == T{ 0 })
+			throw std::domain_error{ "No flows to calculate analytics for" };
+
+		const auto macaulay_duration = T{ time_weighted / pv };
+		const auto modified_duration = T{ macaulay_duration / base };
+
+		return price_analytics<T>{
+			_truncate(pv, quote),
+			macaulay_duration,
+			modified_duration,
+			T{ pv * modified_duration / T{ 10'000 } },
+			T{ convexity_weighted / (base * base * pv) }
+		};
+	}
+
+
+	template<typename T>
+	template<typename Instrument>
+	auto ANBIMA<T>::_price_mixed(
+		const T& yield,
+		const Instrument& instrument,
+		const quote<T>& quote,
+		mixed_precision_counters* counters
+	) const -> T
+	{
+		const auto& truncate = quote.get_truncate();
+		if (truncate) // without truncation there is no boundary to be away from, so only T would do
+		{
+			const auto& settlement_date = quote.get_settlement_date();
+			const auto index = locate_business_day_index(instrument.get_calendar(), _period(instrument, settlement_date));
+
+			const auto settlement = to_serial_day(settlement_date);
+
+			auto p = _double_price{
+				static_cast<double>(yield),
+				static_cast<double>(std::numeric_limits<T>::epsilon())
+			};
+			_for_each_flow(
+				instrument,
+				quote,
+				[&](const T& amount, std::int32_t payment_day)
+				{
+					p.add(static_cast<double>(amount), _business_days(*index, settlement, payment_day));
+				}
+			);
+
+			if (const auto units = p.truncated(*truncate))
+			{
+				if (counters)
+					++counters->fast;
+
+				return _truncate_units(*units, quote);
+			}
+		}
+
+		if (counters)
+			++counters->slow;
+
+		return price(yield, instrument, quote);
+	}
+
+
+	template<typename T>
+	template<typename Instrument>
+	auto ANBIMA<T>::_price_batch_vectorised(
+		std::span<const T> yields,
+		std::span<const Instrument> instruments,
+		const quote<T>& quote,
+		std::span<T> prices,
+		mixed_precision_counters* counters
+	) const -> void
+	{
+		if (prices.size() != instruments.size())
+			throw std::invalid_argument{ "Instruments and prices must have the same size" };
+
+		const auto& truncate = quote.get_truncate();
+		if (!truncate) // as in price_mixed
+		{
+			price_batch(yields, instruments, quote, prices);
+			if (counters)
+				counters->slow += instruments.size();
+			return;
+		}
+
+		const auto& settlement_date = quote.get_settlement_date();
+
+		auto index = _batch_index{ _batch_period(instruments, settlement_date) };
+
+		const auto settlement = to_serial_day(settlement_date);
+
+		const auto reference_epsilon = static_cast<double>(std::numeric_limits<T>::epsilon());
+
+		// instruments go in chunks, so that the flows of a chunk stay in cache between the passes below
+		constexpr auto chunk_flows = 4'096uz;
+
+		auto doubles = std::vector<_double_price>{};
+		auto ends = std::vector<std::size_t>{}; // one past the last flow of each instrument
+		auto amounts = std::vector<double>{};
+		auto year_fractions = std::vector<double>{};
+		auto log_bases = std::vector<double>{};
+		auto factors = std::vector<double>{};
+
+		for (auto first = 0uz; first < instruments.size();)
+		{
+			doubles.clear();
+			ends.clear();
+			amounts.clear();
+			year_fractions.clear();
+			log_bases.clear();
+
+			auto last = first;
+			for (; last < instruments.size() && amounts.size() < chunk_flows; ++last)
+			{
+				const auto& business_day_index = index.get(instruments[last].get_calendar());
+
+				const auto& p = doubles.emplace_back(static_cast<double>(yields[last]), reference_epsilon);
+				_for_each_flow(
+					instruments[last],
+					quote,
+					[&](const T& amount, std::int32_t payment_day)
+					{
+						amounts.push_back(static_cast<double>(amount));
+						year_fractions.push_back(_double_price::year_fraction(_business_days(business_day_index, settlement, payment_day)));
+						log_bases.push_back(p.get_log_base());
+					}
+				);
+				ends.push_back(amounts.size());
+			}
+
+			factors.resize(amounts.size());
+			discount_factors(log_bases, year_fractions, factors);
+
+			auto flow = 0uz;
+			for (auto i = first; i < last; ++i)
+			{
+				auto& p = doubles[i - first];
+				for (; flow < ends[i - first]; ++flow)
+					p.add(amounts[flow], year_fractions[flow], factors[flow]);
+
+				if (const auto units = p.truncated(*truncate))
+				{
+					if (counters)
+						++counters->fast;
+
+					prices[i] = _truncate_units(*units, quote);
+				}
+				else
+				{
+					if (counters)
+						++counters->slow;
+
+					prices[i] = price(yields[i], instruments[i], quote);
+				}
+			}
+
+			first = last;
+		}
+	}
+
+
+	template<typename T>
+	ANBIMA<T>::_double_price::_double_price(double yield, double reference_epsilon) noexcept :
+		yield_{ yield },
+		base_{ 1.0 + yield },
+		log_base_{ std::log(1.0 + yield) },
+		reference_epsilon_{ reference_epsilon }
+	{
+	}
+
+	template<typename T>
+	auto ANBIMA<T>::_double_price::add(double amount, std::int32_t business_days) noexcept -> void
+	{
+		constexpr auto u = std::numeric_limits<double>::epsilon() / 2.0; // unit roundoff
+
+		const auto t = year_fraction(business_days);
+
+		const auto v = amount / std::pow(base_, t);
+
+		price_ += v;
+		magnitude_ += std::abs(v);
+
+		// relative error of v: the yield and 1 + yield (scaled by t through the pow), the year fraction (scaled by log(1 + yield)),
+		// and a rounding each for the amount, the pow (which we allow 2 for) and the division
+		error_ += std::abs(v) * u * (std::abs(t) * (std::abs(yield_) + std::abs(base_)) / std::abs(base_) + std::abs(t * log_base_) + 5.0);
+
+		++flows_;
+	}
+
+	template<typename T>
+	auto ANBIMA<T>::_double_price::add(double amount, double year_fraction, double discount_factor) noexcept -> void
+	{
+		constexpr auto u = std::numeric_limits<double>::epsilon() / 2.0;
+
+		const auto t = year_fraction;
+
+		const auto v = amount * discount_factor;
+
+		price_ += v;
+		magnitude_ += std::abs(v);
+
+		// as above, but log(1 + yield) (which we allow 2 for) and the product with the year fraction are rounded
+		// before the kernel, which then adds its own error
+		error_ += std::abs(v) * (
+			u * (std::abs(t) * (std::abs(yield_) + std::abs(base_)) / std::abs(base_) + 4.0 * std::abs(t * log_base_) + 2.0) +
+			discount_factor_error
+		);
+
+		++flows_;
+	}
+
+	template<typename T>
+	auto ANBIMA<T>::_double_price::truncated(unsigned int truncate) const noexcept -> std::optional<std::int64_t>
+	{
+		constexpr auto u = std::numeric_limits<double>::epsilon() / 2.0;
+		constexpr auto max_units = 4'503'599'627'370'496.0; // 2^52, so units are exact in double
+
+		if (truncate > 15u || !std::isfinite(price_) || !std::isfinite(magnitude_))
+			return std::nullopt;
+
+		// rounding of the summation, and T is not exact either (be generous - this only costs us a slow path now and then)
+		const auto bound = 2.0 * (error_ + static_cast<double>(flows_) * u * magnitude_) +
+			16.0 * reference_epsilon_ * (magnitude_ + static_cast<double>(flows_));
+
+		const auto scale = std::pow(10.0, static_cast<double>(truncate)); // exact
+		const auto lo = (price_ - bound) * scale * (1.0 - 2.0 * u);
+		const auto hi = (price_ + bound) * scale * (1.0 + 2.0 * u);
+
+		if (!(lo > 0.0) || !(hi < max_units))
+			return std::nullopt;
+
+		const auto units = std::floor(lo);
+		if (units != std::floor(hi))
+			return std::nullopt;
+
+		return static_cast<std::int64_t>(units);
+	}
+
+	template<typename T>
+	auto ANBIMA<T>::_double_price::get_log_base() const noexcept -> double
+	{
+		return log_base_;
+	}
+
+	template<typename T>
+	auto ANBIMA<T>::_double_price::year_fraction(std::int32_t business_days) noexcept -> double
+	{
+		const auto whole_years = business_days / 252;
+		const auto digits = std::int64_t{ business_days % 252 } * 100'000'000'000'000 / 252;
+		return static_cast<double>(whole_years * std::int64_t{ 100'000'000'000'000 } + digits) / 1e14;
+	}
+
+
+	template<typename T>
+	ANBIMA<T>::_batch_index::_batch_index(gregorian::util::days_period period) noexcept :
+		period_{ std::move(period) }
+	{
+	}
+
+	template<typename T>
+	auto ANBIMA<T>::_batch_index::get(const gregorian::calendar& cal) -> const business_day_index&
+	{
+		if (!cal_ || (&cal != cal_ && !(cal == *cal_))) // instruments might have their own copies of the same calendar
+		{
+			index_ = locate_business_day_index(cal, period_);
+			cal_ = &cal;
+		}
+
+		return *index_;
+	}
+
+
+	// safeguarded Newton: the price is strictly decreasing in the yield (for positive flows),
+	// so we keep a bracket around the root and fall back to bisection whenever a Newton step leaves it
+	// (year fractions are computed once, so each iteration costs one pow per flow rather than a full repricing)
+	template<typename T>
+	auto ANBIMA<T>::_solve_yield(
+		const T& price,
+		const discounted_flows& flows,
+		const quote<T>& quote
+	) -> T
+	{
+		using std::abs;
+		using std::pow;
+
+		if (!(price > T{ 0 }))
+			throw std::domain_error{ "Price must be positive" };
+
+		const auto one = T{ 1 };
+		const auto two = T{ 2 };
+
+		// truncated price p comes from any untruncated price in [p, p + 10^-truncate)
+		const auto& truncate = quote.get_truncate();
+		const auto target = truncate ?
+			T{ price + pow(T{ 10 }, -static_cast<int>(*truncate)) / two } :
+			price;
+
+		// f(y) = sum(a * (1 + y)^-t) - target, f'(y) = -sum(t * a * (1 + y)^(-t - 1))
+		const auto f = [&](const T& y, T& df) -> T
+		{
+			auto pv = T{ 0 };
+			df = T{ 0 };
+			for (const auto& [amount, yf] : flows)
+			{
+				const auto v = T{ amount * pow(one + y, -yf) };
+				pv += v;
+				df -= yf * v / (one + y);
+			}
+			return pv - target;
+		};
+
+		// initial guess treats all flows as a single payment at their amount weighted time
+		auto total = T{ 0 };
+		auto weighted = T{ 0 };
+		for (const auto& [amount, yf] : flows)
+		{
+			total += amount;
+			weighted += amount * yf;
+		}
+		if (!(weighted > T{ 0 }))
+			throw std::domain_error{ "No flows to solve the yield for" };
+
+		auto y = T{ pow(total / target, total / weighted) - one };
+
+		auto lo = T{ -1 }; // f(lo) > 0 (price goes to infinity as the yield approaches -100%)
+		auto hi = T{ 0 }; // f(hi) < 0 is established below
+		auto hi_found = false;
+
+		const auto tolerance = std::numeric_limits<T>::epsilon() * 16;
+		constexpr auto max_iterations = 200;
+
+		for (auto i = 0; i < max_iterations; ++i)
+		{
+			auto df = T{ 0 };
+			const auto fy = f(y, df);
+			if (fy == T{ 0 })
+				return y;
+
+			if (fy > T{ 0 })
+				lo = y;
+			else
+			{
+				hi = y;
+				hi_found = true;
+			}
+
+			auto next = T{ y - fy / df };
+			if (!(next > lo) || (hi_found && !(next < hi)))
+				next = hi_found ? (lo + hi) / two : (y > T{ 0 } ? y * two : one); // bisect, or widen the search
+
+			if (abs(next - y) <= tolerance * (one + abs(y)))
+				return next;
+
+			y = next;
+		}
+
+		throw std::runtime_error{ "Yield did not converge" };
 	}
 
 }
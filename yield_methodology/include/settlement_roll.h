@@ -0,0 +1,324 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <span>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include <resets_math.h>
+
+#include <period.h>
+#include <calendar.h>
+
+#include <business_day_index.h>
+#include <discount_table.h>
+#include <flow_block.h>
+#include <shared_calendar.h>
+
+#include <bill.h>
+#include <bond.h>
+#include <quote.h>
+
+
+namespace debt_security
+{
+
+	// ANBIMA price of an instrument as its settlement date rolls forward, day after day,
+	// without rebuilding the flows or counting business days again:
+	// each flow keeps its business day ordinal, so rolling is a single lookup for the new settlement date,
+	// and flows paid on or before the settlement date are dropped as it passes them
+	// (as in ANBIMA::price, so the price is always the same as from scratch)
+	template<typename T = double>
+	class settlement_roll final
+	{
+
+	public:
+
+		explicit settlement_roll(const bill<T>& bill, const quote<T>& quote);
+		explicit settlement_roll(const bond<T>& bond, const quote<T>& quote);
+
+	public:
+
+		auto get_settlement_date() const noexcept -> const std::chrono::year_month_day&;
+
+		auto size() const noexcept -> std::size_t; // flows still to be paid
+		auto empty() const noexcept -> bool;
+
+		// business days from the settlement date to the i-th flow still to be paid
+		auto business_days(std::size_t i) const noexcept -> std::int32_t;
+
+	public:
+
+		// to any later settlement date (or the same one)
+		auto roll_to(const std::chrono::year_month_day& settlement_date) -> void;
+
+		// to the settlement date the given number of business days later
+		auto advance(std::int32_t business_days = 1) -> void;
+
+	public:
+
+		// throws std::domain_error once all flows have been paid
+		auto price(const T& yield) const -> T;
+
+	private:
+
+		explicit settlement_roll(
+			const flow_block<T>& flows,
+			shared_calendar cal,
+			const quote<T>& quote
+		);
+
+		auto _ordinals() -> void; // of the flows, from the index
+
+	private:
+
+		shared_calendar cal_;
+		std::optional<unsigned int> truncate_;
+
+		std::shared_ptr<const business_day_index> index_{};
+
+		std::vector<T> amounts_{};
+		std::vector<std::int32_t> payment_days_{};
+		std::vector<std::int32_t> payment_ordinals_{};
+		std::size_t first_{ 0uz }; // the first flow still to be paid
+
+		std::chrono::year_month_day settlement_date_;
+		std::int32_t settlement_ordinal_{ 0 };
+
+	};
+
+
+	// prices[i] is the ANBIMA price at the yield on settlement_dates[i], from a single settlement_roll
+	// (so the dates have to be in order, and the quote only gives the face and the truncation)
+	template<typename T>
+	auto price_series(
+		const T& yield,
+		const bill<T>& bill,
+		const quote<T>& quote,
+		std::span<const std::chrono::year_month_day> settlement_dates,
+		std::span<std::type_identity_t<T>> prices
+	) -> void;
+
+	template<typename T>
+	auto price_series(
+		const T& yield,
+		const bond<T>& bond,
+		const quote<T>& quote,
+		std::span<const std::chrono::year_month_day> settlement_dates,
+		std::span<std::type_identity_t<T>> prices
+	) -> void;
+
+
+	template<typename T>
+	settlement_roll<T>::settlement_roll(const bill<T>& bill, const quote<T>& quote) :
+		settlement_roll{
+			flow_block<T>{ fin_calendar::cash_flow<T>{ bill.cash_flow().get_payment_date(), quote.get_face() } }, // as in ANBIMA::price
+			bill.get_shared_calendar(),
+			quote
+		}
+	{
+	}
+
+	template<typename T>
+	settlement_roll<T>::settlement_roll(const bond<T>& bond, const quote<T>& quote) :
+		settlement_roll{ bond.flow_block(), bond.get_shared_calendar(), quote }
+	{
+	}
+
+	template<typename T>
+	settlement_roll<T>::settlement_roll(
+		const flow_block<T>& flows,
+		shared_calendar cal,
+		const quote<T>& quote
+	) :
+		cal_{ std::move(cal) },
+		truncate_{ quote.get_truncate() },
+		amounts_(flows.get_amounts().begin(), flows.get_amounts().end()),
+		payment_days_(flows.get_payment_days().begin(), flows.get_payment_days().end()),
+		settlement_date_{ quote.get_settlement_date() }
+	{
+		const auto settlement = to_serial_day(settlement_date_);
+
+		first_ = static_cast<std::size_t>(std::ranges::upper_bound(payment_days_, settlement) - payment_days_.begin());
+		if (first_ == payment_days_.size())
+			return; // nothing to count business days for
+
+		// the index covers all settlement dates we can roll to before the last flow is paid
+		index_ = locate_business_day_index(
+			*cal_,
+			gregorian::util::days_period{ settlement_date_, from_serial_day(payment_days_.back()) }
+		);
+
+		payment_ordinals_.reserve(payment_days_.size());
+		for (const auto day : payment_days_)
+			payment_ordinals_.push_back(day > settlement ? index_->ordinal(day) : 0); // paid flows are never looked at
+
+		settlement_ordinal_ = index_->ordinal(settlement);
+	}
+
+
+	template<typename T>
+	auto settlement_roll<T>::get_settlement_date() const noexcept -> const std::chrono::year_month_day&
+	{
+		return settlement_date_;
+	}
+
+	template<typename T>
+	auto settlement_roll<T>::size() const noexcept -> std::size_t
+	{
+		return payment_days_.size() - first_;
+	}
+
+	template<typename T>
+	auto settlement_roll<T>::empty() const noexcept -> bool
+	{
+		return first_ == payment_days_.size();
+	}
+
+	template<typename T>
+	auto settlement_roll<T>::business_days(std::size_t i) const noexcept -> std::int32_t
+	{
+		return payment_ordinals_[first_ + i] - settlement_ordinal_;
+	}
+
+
+	template<typename T>
+	auto settlement_roll<T>::roll_to(const std::chrono::year_month_day& settlement_date) -> void
+	{
+		if (settlement_date < settlement_date_)
+			throw std::invalid_argument{ "Settlement date can only roll forward" };
+
+		settlement_date_ = settlement_date;
+
+		const auto settlement = to_serial_day(settlement_date_);
+		while (first_ < payment_days_.size() && payment_days_[first_] <= settlement)
+			++first_; // paid
+
+		if (first_ < payment_days_.size())
+			settlement_ordinal_ = index_->ordinal(settlement); // the index covers everything up to the last flow
+	}
+
+	template<typename T>
+	auto settlement_roll<T>::advance(std::int32_t business_days) -> void
+	{
+		if (business_days < 0)
+			throw std::invalid_argument{ "Settlement date can only roll forward" };
+
+		auto day = std::chrono::sys_days{ settlement_date_ };
+		for (auto n = 0; n < business_days;)
+		{
+			day += std::chrono::days{ 1 };
+			if (cal_->is_business_day(day))
+				++n;
+		}
+
+		roll_to(std::chrono::year_month_day{ day });
+	}
+
+
+	template<typename T>
+	auto settlement_roll<T>::price(const T& yield) const -> T
+	{
+		if (empty())
+			throw std::domain_error{ "No flows after the settlement date" };
+
+		const auto base = T{ T{ 1 } + yield };
+
+		auto price = T{ 0 };
+		for (auto i = first_; i < amounts_.size(); ++i)
+			price += T{ amounts_[i] / pow(base, year_fraction_252<T>(payment_ordinals_[i] - settlement_ordinal_)) }; // exactly as in ANBIMA::price
+
+		if (truncate_)
+			return reset::trunc_dp(price, *truncate_);
+		else
+			return price;
+	}
+
+
+	namespace _settlement_roll
+	{
+
+		template<typename T, typename Instrument>
+		auto price_series(
+			const T& yield,
+			const Instrument& instrument,
+			const quote<T>& quote,
+			std::span<const std::chrono::year_month_day> settlement_dates,
+			std::span<T> prices
+		) -> void
+		{
+			if (prices.size() != settlement_dates.size())
+				throw std::invalid_argument{ "Settlement dates and prices must have the same size" };
+			if (settlement_dates.empty())
+				return;
+			if (!std::ranges::is_sorted(settlement_dates))
+				throw std::invalid_argument{ "Settlement dates must be in order" };
+
+			auto roll = settlement_roll<T>{
+				instrument,
+				debt_security::quote<T>{ settlement_dates.front(), quote.get_face(), quote.get_truncate() }
+			};
+
+			for (auto i = 0uz; i < settlement_dates.size(); ++i)
+			{
+				roll.roll_to(settlement_dates[i]);
+				prices[i] = roll.price(yield);
+			}
+		}
+
+	}
+
+
+	template<typename T>
+	auto price_series(
+		const T& yield,
+		const bill<T>& bill,
+		const quote<T>& quote,
+		std::span<const std::chrono::year_month_day> settlement_dates,
+		std::span<std::type_identity_t<T>> prices
+	) -> void
+	{
+		_settlement_roll::price_series(yield, bill, quote, settlement_dates, prices);
+	}
+
+	template<typename T>
+	auto price_series(
+		const T& yield,
+		const bond<T>& bond,
+		const quote<T>& quote,
+		std::span<const std::chrono::year_month_day> settlement_dates,
+		std::span<std::type_identity_t<T>> prices
+	) -> void
+	{
+		_settlement_roll::price_series(yield, bond, quote, settlement_dates, prices);
+	}
+
+}
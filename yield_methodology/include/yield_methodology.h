@@ -25,8 +25,12 @@
 #include <chrono>
 #include <utility>
 #include <variant>
+#include <span>
+#include <concepts>
+#include <type_traits>
 
 #include <bill.h>
+#include <bond.h>
 #include <quote.h>
 
 #include "ANBIMA.h"
@@ -35,11 +39,71 @@
 namespace debt_security
 {
 
+	// what a yield methodology has to provide, so it can be bound at compile time (and inlined into hot loops)
+	template<typename M, typename T>
+	concept static_yield_methodology = requires(
+		const M& m,
+		const T& value,
+		const bill<T>& bill,
+		const bond<T>& bond,
+		const quote<T>& quote,
+		std::span<const T> yields,
+		std::span<const debt_security::bill<T>> bills,
+		std::span<const debt_security::bond<T>> bonds,
+		std::span<T> prices
+	)
+	{
+		{ m.price(value, bill, quote) } -> std::same_as<T>;
+		{ m.price(value, bond, quote) } -> std::same_as<T>;
+		{ m.yield(value, bill, quote) } -> std::same_as<T>;
+		{ m.yield(value, bond, quote) } -> std::same_as<T>;
+		m.price_batch(yields, bills, quote, prices);
+		m.price_batch(yields, bonds, quote, prices);
+	};
+
+
+	// for a methodology chosen at run time (each alternative should satisfy static_yield_methodology)
 	template<typename T = double>
 	using yield_methodology = std::variant<
 		ANBIMA<T>
-	>; // for starters just for bills
+	>;
+
+	static_assert(static_yield_methodology<ANBIMA<double>, double>);
+
 
+	// the variant is visited once, and then f(methodology) runs against the concrete type
+	// (so a whole loop inside f is bound at compile time)
+	template<typename T, typename F>
+	inline auto with_yield_methodology(
+		const yield_methodology<T>& yield_methodology,
+		F&& f
+	) -> decltype(auto)
+	{
+		return std::visit(std::forward<F>(f), yield_methodology);
+	}
+
+
+	template<typename T, static_yield_methodology<T> M>
+	inline auto yield_to_price(
+		const T& yield,
+		const bill<T>& bill,
+		const quote<T>& quote,
+		const M& yield_methodology
+	) -> T
+	{
+		return yield_methodology.price(yield, bill, quote);
+	}
+
+	template<typename T, static_yield_methodology<T> M>
+	inline auto yield_to_price(
+		const T& yield,
+		const bond<T>& bond,
+		const quote<T>& quote,
+		const M& yield_methodology
+	) -> T
+	{
+		return yield_methodology.price(yield, bond, quote);
+	}
 
 	template<typename T = double>
 	inline auto yield_to_price(
@@ -49,12 +113,148 @@ namespace debt_security
 		const yield_methodology<T>& yield_methodology
 	) -> T
 	{
-		return std::visit(
+		return with_yield_methodology(
+			yield_methodology,
+			[&](const auto& yield_methodology)
+			{
+				return yield_to_price(yield, bill, quote, yield_methodology);
+			}
+		);
+	}
+
+	template<typename T = double>
+	inline auto yield_to_price(
+		const T& yield,
+		const bond<T>& bond,
+		const quote<T>& quote,
+		const yield_methodology<T>& yield_methodology
+	) -> T
+	{
+		return with_yield_methodology(
+			yield_methodology,
+			[&](const auto& yield_methodology)
+			{
+				return yield_to_price(yield, bond, quote, yield_methodology);
+			}
+		);
+	}
+
+
+	// T is deduced from the quote only, so the spans can be passed in as vectors, arrays, etc.
+	template<typename T, static_yield_methodology<T> M>
+	inline auto yield_to_price_batch(
+		std::span<const std::type_identity_t<T>> yields,
+		std::span<const bill<std::type_identity_t<T>>> bills,
+		const quote<T>& quote,
+		const M& yield_methodology,
+		std::span<std::type_identity_t<T>> prices
+	) -> void
+	{
+		yield_methodology.price_batch(yields, bills, quote, prices);
+	}
+
+	template<typename T, static_yield_methodology<T> M>
+	inline auto yield_to_price_batch(
+		std::span<const std::type_identity_t<T>> yields,
+		std::span<const bond<std::type_identity_t<T>>> bonds,
+		const quote<T>& quote,
+		const M& yield_methodology,
+		std::span<std::type_identity_t<T>> prices
+	) -> void
+	{
+		yield_methodology.price_batch(yields, bonds, quote, prices);
+	}
+
+	template<typename T = double>
+	inline auto yield_to_price_batch(
+		std::span<const std::type_identity_t<T>> yields,
+		std::span<const bill<std::type_identity_t<T>>> bills,
+		const quote<T>& quote,
+		const yield_methodology<T>& yield_methodology,
+		std::span<std::type_identity_t<T>> prices
+	) -> void
+	{
+		with_yield_methodology(
+			yield_methodology,
+			[&](const auto& yield_methodology)
+			{
+				yield_to_price_batch(yields, bills, quote, yield_methodology, prices);
+			}
+		);
+	}
+
+	template<typename T = double>
+	inline auto yield_to_price_batch(
+		std::span<const std::type_identity_t<T>> yields,
+		std::span<const bond<std::type_identity_t<T>>> bonds,
+		const quote<T>& quote,
+		const yield_methodology<T>& yield_methodology,
+		std::span<std::type_identity_t<T>> prices
+	) -> void
+	{
+		with_yield_methodology(
+			yield_methodology,
+			[&](const auto& yield_methodology)
+			{
+				yield_to_price_batch(yields, bonds, quote, yield_methodology, prices);
+			}
+		);
+	}
+
+
+	template<typename T, static_yield_methodology<T> M>
+	inline auto price_to_yield(
+		const T& price,
+		const bill<T>& bill,
+		const quote<T>& quote,
+		const M& yield_methodology
+	) -> T
+	{
+		return yield_methodology.yield(price, bill, quote);
+	}
+
+	template<typename T, static_yield_methodology<T> M>
+	inline auto price_to_yield(
+		const T& price,
+		const bond<T>& bond,
+		const quote<T>& quote,
+		const M& yield_methodology
+	) -> T
+	{
+		return yield_methodology.yield(price, bond, quote);
+	}
+
+	template<typename T = double>
+	inline auto price_to_yield(
+		const T& price,
+		const bill<T>& bill,
+		const quote<T>& quote, // this is for the price we start from (we need to know how it was truncated)
+		const yield_methodology<T>& yield_methodology
+	) -> T
+	{
+		return with_yield_methodology(
+			yield_methodology,
+			[&](const auto& yield_methodology)
+			{
+				return price_to_yield(price, bill, quote, yield_methodology);
+			}
+		);
+	}
+
+	template<typename T = double>
+	inline auto price_to_yield(
+		const T& price,
+		const bond<T>& bond,
+		const quote<T>& quote,
+		const yield_methodology<T>& yield_methodology
+	) -> T
+	{
+		return with_yield_methodology(
+			yield_methodology,
 			[&](const auto& yield_methodology)
 			{
-				return yield_methodology.price(yield, bill, quote);
-			},
-			yield_methodology
+				return price_to_yield(price, bond, quote, yield_methodology);
+			}
 		);
 	}
 
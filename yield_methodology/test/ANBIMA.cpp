@@ -23,6 +23,8 @@
 #include <boost/multiprecision/cpp_dec_float.hpp>
 
 #include <ANBIMA.h>
+#include <discount_table.h>
+#include <fixed_decimal.h>
 #include <bill.h>
 #include <bond.h>
 #include <quote.h>
@@ -37,6 +39,10 @@
 #include <gtest/gtest.h>
 
 #include <string>
+#include <vector>
+#include <array>
+#include <span>
+#include <stdexcept>
 
 using namespace std;
 using namespace std::chrono;
@@ -229,4 +235,987 @@ namespace debt_security // should we mock the ANBIMA calendar?
 		EXPECT_EQ(price, cpp_dec_float_50{ "100.1158" });
 	}
 
+	TEST(ANBIMA, LTN_yield1)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto LTN = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = ANBIMA.yield(753.315323, LTN, quote);
+		EXPECT_NEAR(yield, from_percent(14.36), 1e-8);
+		EXPECT_EQ(ANBIMA.price(yield, LTN, quote), 753.315323);
+	}
+
+	TEST(ANBIMA, LTN_yield2)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto LTN = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA<cpp_dec_float_50>{};
+
+		const auto yield = ANBIMA.yield(cpp_dec_float_50{ "753.315323" }, LTN, quote);
+		EXPECT_EQ(round_dp(yield, 6u), from_percent(cpp_dec_float_50{ "14.36" }));
+		EXPECT_EQ(ANBIMA.price(yield, LTN, quote), cpp_dec_float_50{ "753.315323" });
+	}
+
+	TEST(ANBIMA, NTN_F_yield1)
+	{
+		const auto issue_date = 2008y / January / 1d; // made up?
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+		const auto NTN_F = debt_security::bond{
+			issue_date,
+			maturity_date,
+			frequency,
+			coupon,
+			calendar,
+			face,
+			round_flows
+		};
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = ANBIMA.yield(903.075616, NTN_F, quote);
+		EXPECT_NEAR(yield, from_percent(13.66), 1e-8);
+		EXPECT_EQ(ANBIMA.price(yield, NTN_F, quote), 903.075616);
+	}
+
+	TEST(ANBIMA, NTN_F_yield2)
+	{
+		const auto issue_date = 2008y / January / 1d; // made up?
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = cpp_dec_float_50{ 10 };
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto round_flows = 5u;
+		const auto NTN_F = debt_security::bond{
+			issue_date,
+			maturity_date,
+			frequency,
+			coupon,
+			calendar,
+			face,
+			round_flows
+		};
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA<cpp_dec_float_50>{};
+
+		const auto yield = ANBIMA.yield(cpp_dec_float_50{ "903.075616" }, NTN_F, quote);
+		EXPECT_EQ(round_dp(yield, 6u), from_percent(cpp_dec_float_50{ "13.66" }));
+		EXPECT_EQ(ANBIMA.price(yield, NTN_F, quote), cpp_dec_float_50{ "903.075616" });
+	}
+
+	TEST(ANBIMA, NTN_F_yield3)
+	{
+		const auto issue_date = 2008y / January / 1d;
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+		const auto NTN_F = debt_security::bond{ issue_date, maturity_date, frequency, coupon, calendar, face, round_flows };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = from_percent(13.66);
+
+		// seasoned bonds, so coupons paid before settlement are not part of the price or of the yield
+		for (const auto settlement_date : { 2012y / May / 21d, 2013y / May / 21d, 2013y / July / 1d, 2013y / December / 2d })
+		{
+			const auto quote = debt_security::quote{ settlement_date, face, 6u };
+
+			const auto price = ANBIMA.price(yield, NTN_F, quote);
+			EXPECT_LT(price, face + 2.0 * 48.80885); // at most the principal and two coupons left
+
+			const auto y = ANBIMA.yield(price, NTN_F, quote);
+			EXPECT_NEAR(y, yield, 1e-6);
+			EXPECT_EQ(ANBIMA.price(y, NTN_F, quote), price);
+		}
+
+		// nothing left to pay
+		const auto quote = debt_security::quote{ 2014y / January / 2d, face, 6u };
+		EXPECT_EQ(ANBIMA.price(yield, NTN_F, quote), 0.0);
+		EXPECT_THROW(ANBIMA.yield(1'000.0, NTN_F, quote), domain_error);
+	}
+
+	TEST(ANBIMA, LFT_yield1)
+	{
+		const auto issue_date = 2000y / July / 1d; // made up (does not matter)
+		const auto maturity_date = 2014y / March / 7d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 100.0;
+		const auto LFT = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 4u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = ANBIMA.yield(100.1158, LFT, quote); // negative yield
+		EXPECT_LT(yield, 0.0);
+		EXPECT_EQ(ANBIMA.price(yield, LFT, quote), 100.1158);
+	}
+
+	TEST(ANBIMA, yield_bad_price1)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto LTN = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto quote = debt_security::quote{ settlement_date, face };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		EXPECT_THROW(ANBIMA.yield(0.0, LTN, quote), domain_error);
+	}
+
+	TEST(ANBIMA, price_batch1)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto bills = vector{
+			debt_security::bill{ issue_date, 2008y / July / 1d, calendar, face },
+			debt_security::bill{ issue_date, 2010y / July / 1d, calendar, face },
+			debt_security::bill{ issue_date, 2014y / March / 7d, calendar, face }
+		};
+		const auto yields = vector{ from_percent(12.5), from_percent(14.36), from_percent(13.0) };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		auto prices = vector<double>(bills.size());
+		ANBIMA.price_batch(yields, bills, quote, prices);
+
+		for (auto i = 0uz; i < bills.size(); ++i)
+			EXPECT_EQ(prices[i], ANBIMA.price(yields[i], bills[i], quote));
+		EXPECT_EQ(prices[1], 753.315323);
+	}
+
+	TEST(ANBIMA, price_batch2)
+	{
+		const auto issue_date = 2008y / January / 1d; // made up?
+		const auto frequency = SemiAnnual;
+		const auto coupon = cpp_dec_float_50{ 10 };
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto round_flows = 5u;
+		const auto bonds = vector{
+			debt_security::bond{ issue_date, 2012y / January / 1d, frequency, coupon, calendar, face, round_flows },
+			debt_security::bond{ issue_date, 2014y / January / 1d, frequency, coupon, calendar, face, round_flows }
+		};
+		const auto yields = vector{ from_percent(cpp_dec_float_50{ "13.1" }), from_percent(cpp_dec_float_50{ "13.66" }) };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA<cpp_dec_float_50>{};
+
+		auto prices = vector<cpp_dec_float_50>(bonds.size());
+		ANBIMA.price_batch(yields, bonds, quote, prices);
+
+		for (auto i = 0uz; i < bonds.size(); ++i)
+			EXPECT_EQ(prices[i], ANBIMA.price(yields[i], bonds[i], quote));
+		EXPECT_EQ(prices[1], cpp_dec_float_50{ "903.075616" });
+	}
+
+	TEST(ANBIMA, price_batch3)
+	{
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto bills = vector{ debt_security::bill{ 2007y / July / 1d, 2010y / July / 1d, calendar } };
+		const auto yields = vector{ 0.1, 0.2 };
+
+		const auto quote = debt_security::quote{ 2008y / May / 21d };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		auto prices = vector<double>(bills.size());
+		EXPECT_THROW(ANBIMA.price_batch(yields, bills, quote, prices), invalid_argument);
+	}
+
+	TEST(ANBIMA, discount_table1)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto LTN = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA<cpp_dec_float_50>{};
+
+		const auto yield = from_percent(cpp_dec_float_50{ "14.36" });
+		const auto table = discount_table{ yield, 2'000 };
+		EXPECT_EQ(ANBIMA.price(table, LTN, quote), cpp_dec_float_50{ "753.315323" });
+		EXPECT_EQ(ANBIMA.price(table, LTN, quote), ANBIMA.price(yield, LTN, quote));
+	}
+
+	TEST(ANBIMA, discount_table2)
+	{
+		const auto issue_date = 2008y / January / 1d; // made up?
+		const auto frequency = SemiAnnual;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+		const auto bonds = vector{
+			debt_security::bond{ issue_date, 2012y / January / 1d, frequency, coupon, calendar, face, round_flows },
+			debt_security::bond{ issue_date, 2014y / January / 1d, frequency, coupon, calendar, face, round_flows }
+		};
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = from_percent(13.66);
+		const auto table = discount_table{ yield, 2'000 };
+
+		auto prices = vector<double>(bonds.size());
+		ANBIMA.price_batch(table, span{ bonds }, quote, span{ prices });
+
+		EXPECT_EQ(prices[0], ANBIMA.price(yield, bonds[0], quote));
+		EXPECT_EQ(prices[1], 903.075616);
+		EXPECT_EQ(ANBIMA.price(table, bonds[1], quote), 903.075616);
+	}
+
+	TEST(ANBIMA, discount_table3)
+	{
+		const auto issue_date = 2008y / January / 1d; // made up?
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+		const auto NTN_F = debt_security::bond{ issue_date, maturity_date, frequency, coupon, calendar, face, round_flows };
+
+		// a seasoned bond, with two coupons paid before settlement
+		const auto settlement_date = 2009y / March / 16d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = from_percent(13.66);
+		const auto table = discount_table{ yield, 2'000 };
+
+		EXPECT_EQ(ANBIMA.price(table, NTN_F, quote), ANBIMA.price(yield, NTN_F, quote));
+
+		auto prices = vector<double>(1uz);
+		ANBIMA.price_batch(table, span{ &NTN_F, 1uz }, quote, span{ prices });
+		EXPECT_EQ(prices.front(), ANBIMA.price(yield, NTN_F, quote));
+	}
+
+	TEST(ANBIMA, LTN3)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = fixed_decimal{ 1'000 };
+		const auto LTN = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA<fixed_decimal<>>{};
+
+		const auto yield = from_percent(fixed_decimal{ "14.36" });
+		EXPECT_EQ(ANBIMA.price(yield, LTN, quote), fixed_decimal{ "753.315323" });
+
+		const auto table = discount_table{ yield, 2'000 };
+		EXPECT_EQ(ANBIMA.price(table, LTN, quote), fixed_decimal{ "753.315323" });
+
+		const auto y = ANBIMA.yield(fixed_decimal{ "753.315323" }, LTN, quote);
+		EXPECT_EQ(round_dp(y, 6u), yield);
+	}
+
+	TEST(ANBIMA, NTN_F3)
+	{
+		const auto issue_date = 2008y / January / 1d; // made up?
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = fixed_decimal{ 10 };
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = fixed_decimal{ 1'000 };
+		const auto round_flows = 5u;
+		const auto NTN_F = debt_security::bond{
+			issue_date,
+			maturity_date,
+			frequency,
+			coupon,
+			calendar,
+			face,
+			round_flows
+		};
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA<fixed_decimal<>>{};
+
+		const auto yield = from_percent(fixed_decimal{ "13.66" });
+		EXPECT_EQ(ANBIMA.price(yield, NTN_F, quote), fixed_decimal{ "903.075616" });
+
+		const auto y = ANBIMA.yield(fixed_decimal{ "903.075616" }, NTN_F, quote);
+		EXPECT_EQ(round_dp(y, 6u), yield);
+	}
+
+	TEST(ANBIMA, LFT3)
+	{
+		const auto issue_date = 2000y / July / 1d; // made up (does not matter)
+		const auto maturity_date = 2014y / March / 7d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = fixed_decimal{ 100 };
+		const auto LFT = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 4u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA<fixed_decimal<>>{};
+
+		const auto yield = from_percent(fixed_decimal{ "-0.02" });
+		EXPECT_EQ(ANBIMA.price(yield, LFT, quote), fixed_decimal{ "100.1158" });
+	}
+
+	TEST(ANBIMA, price_mixed1)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto LTN = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA<cpp_dec_float_50>{};
+
+		auto counters = mixed_precision_counters{};
+
+		const auto yield = from_percent(cpp_dec_float_50{ "14.36" });
+		EXPECT_EQ(ANBIMA.price_mixed(yield, LTN, quote, &counters), cpp_dec_float_50{ "753.315323" });
+		EXPECT_EQ(counters.fast, 1u);
+		EXPECT_EQ(counters.slow, 0u);
+	}
+
+	TEST(ANBIMA, price_mixed2)
+	{
+		// the same sweep as in example/dec_vs_bin
+		const auto issue_date = 2008y / May / 21d;
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto LTN = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ issue_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA<cpp_dec_float_50>{};
+
+		auto counters = mixed_precision_counters{};
+
+		auto n = 0u;
+		for (auto yield = cpp_dec_float_50{ "5" }; yield <= cpp_dec_float_50{ "15" }; yield += cpp_dec_float_50{ "0.01" }, ++n)
+		{
+			const auto y = from_percent(yield);
+			EXPECT_EQ(ANBIMA.price_mixed(y, LTN, quote, &counters), ANBIMA.price(y, LTN, quote));
+		}
+
+		EXPECT_EQ(counters.fast + counters.slow, n);
+		EXPECT_LT(counters.slow, n / 100u);
+	}
+
+	TEST(ANBIMA, price_mixed3)
+	{
+		const auto issue_date = 2008y / January / 1d; // made up?
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = cpp_dec_float_50{ 10 };
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto round_flows = 5u;
+		const auto NTN_F = debt_security::bond{
+			issue_date,
+			maturity_date,
+			frequency,
+			coupon,
+			calendar,
+			face,
+			round_flows
+		};
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA<cpp_dec_float_50>{};
+
+		auto counters = mixed_precision_counters{};
+
+		EXPECT_EQ(ANBIMA.price_mixed(from_percent(cpp_dec_float_50{ "13.66" }), NTN_F, quote, &counters), cpp_dec_float_50{ "903.075616" });
+
+		for (auto yield = cpp_dec_float_50{ "10" }; yield <= cpp_dec_float_50{ "15" }; yield += cpp_dec_float_50{ "0.05" })
+		{
+			const auto y = from_percent(yield);
+			EXPECT_EQ(ANBIMA.price_mixed(y, NTN_F, quote), ANBIMA.price(y, NTN_F, quote));
+		}
+
+		EXPECT_EQ(counters.fast, 1u);
+	}
+
+	TEST(ANBIMA, price_mixed4)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto LTN = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto quote = debt_security::quote{ settlement_date, face }; // no truncation
+
+		const auto ANBIMA = debt_security::ANBIMA<cpp_dec_float_50>{};
+
+		auto counters = mixed_precision_counters{};
+
+		const auto yield = from_percent(cpp_dec_float_50{ "14.36" });
+		EXPECT_EQ(ANBIMA.price_mixed(yield, LTN, quote, &counters), ANBIMA.price(yield, LTN, quote));
+		EXPECT_EQ(counters.fast, 0u);
+		EXPECT_EQ(counters.slow, 1u);
+	}
+
+	TEST(ANBIMA, price_mixed5)
+	{
+		const auto issue_date = 2008y / May / 21d;
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto LTN = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ issue_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA<cpp_dec_float_50>{};
+
+		auto counters = mixed_precision_counters{};
+
+		// yields which put the price right next to a truncation boundary (from either side)
+		const auto exact = debt_security::quote{ issue_date, face };
+		for (const auto& p : { "902.100000000000000000001", "902.099999999999999999999" })
+		{
+			const auto y = ANBIMA.yield(cpp_dec_float_50{ p }, LTN, exact);
+			EXPECT_EQ(ANBIMA.price_mixed(y, LTN, quote, &counters), ANBIMA.price(y, LTN, quote));
+		}
+
+		EXPECT_EQ(counters.fast, 0u);
+		EXPECT_EQ(counters.slow, 2u);
+	}
+
+	TEST(ANBIMA, analytics1)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto LTN = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA<cpp_dec_float_50>{};
+
+		const auto yield = from_percent(cpp_dec_float_50{ "14.36" });
+		const auto a = ANBIMA.analytics(yield, LTN, quote);
+
+		// a single flow, so the duration is just its year fraction
+		const auto t = cpp_dec_float_50{ "2.11111111111111" };
+		const auto base = cpp_dec_float_50{ 1 + yield };
+		EXPECT_EQ(a.price, cpp_dec_float_50{ "753.315323" });
+		EXPECT_LT(abs(a.macaulay_duration - t), cpp_dec_float_50{ "1e-40" });
+		EXPECT_LT(abs(a.modified_duration - t / base), cpp_dec_float_50{ "1e-40" });
+		EXPECT_LT(abs(a.convexity - t * (t + 1) / (base * base)), cpp_dec_float_50{ "1e-40" });
+		EXPECT_NEAR(static_cast<double>(a.dv01), 0.139064, 1e-6);
+	}
+
+	TEST(ANBIMA, analytics2)
+	{
+		const auto issue_date = 2008y / January / 1d; // made up?
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+		const auto NTN_F = debt_security::bond{
+			issue_date,
+			maturity_date,
+			frequency,
+			coupon,
+			calendar,
+			face,
+			round_flows
+		};
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = from_percent(13.66);
+		const auto a = ANBIMA.analytics(yield, NTN_F, quote);
+		EXPECT_EQ(a.price, 903.075616);
+		EXPECT_EQ(a.price, ANBIMA.price(yield, NTN_F, quote));
+
+		// against finite differences (without truncation)
+		const auto untruncated = debt_security::quote{ settlement_date, face };
+		const auto h = 1e-4;
+		const auto p = ANBIMA.price(yield, NTN_F, untruncated);
+		const auto p_down = ANBIMA.price(yield - h, NTN_F, untruncated);
+		const auto p_up = ANBIMA.price(yield + h, NTN_F, untruncated);
+
+		EXPECT_NEAR(a.dv01, (p_down - p_up) / 2.0, 1e-6);
+		EXPECT_NEAR(a.modified_duration, (p_down - p_up) / (2.0 * h * p), 1e-6);
+		EXPECT_NEAR(a.macaulay_duration, a.modified_duration * (1.0 + yield), 1e-12);
+		EXPECT_NEAR(a.convexity, (p_down - 2.0 * p + p_up) / (h * h * p), 1e-3);
+		EXPECT_LT(a.macaulay_duration, 5.6); // less than the time to maturity
+	}
+
+	TEST(ANBIMA, price_batch_vectorised1)
+	{
+		// the LTN vector together with a sweep of yields, all at once
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+
+		auto bills = vector<debt_security::bill<double>>{};
+		auto yields = vector<double>{};
+		for (const auto maturity_date : { 2008y / July / 1d, 2010y / July / 1d, 2014y / March / 7d })
+			for (auto yield = 5.0; yield <= 15.0; yield += 0.01)
+			{
+				bills.emplace_back(issue_date, maturity_date, calendar, face);
+				yields.push_back(from_percent(yield));
+			}
+		bills.emplace_back(issue_date, 2010y / July / 1d, calendar, face);
+		yields.push_back(from_percent(14.36));
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		auto counters = mixed_precision_counters{};
+
+		auto prices = vector<double>(bills.size());
+		ANBIMA.price_batch_vectorised(yields, bills, quote, prices, &counters);
+
+		for (auto i = 0uz; i < bills.size(); ++i)
+			EXPECT_EQ(prices[i], ANBIMA.price(yields[i], bills[i], quote));
+		EXPECT_EQ(prices.back(), 753.315323);
+
+		EXPECT_EQ(counters.fast + counters.slow, bills.size());
+		EXPECT_LT(counters.slow, bills.size() / 100u);
+	}
+
+	TEST(ANBIMA, price_batch_vectorised2)
+	{
+		const auto issue_date = 2008y / January / 1d; // made up?
+		const auto frequency = SemiAnnual;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+
+		auto bonds = vector<debt_security::bond<double>>{};
+		auto yields = vector<double>{};
+		for (const auto maturity_date : { 2012y / January / 1d, 2014y / January / 1d, 2017y / January / 1d })
+			for (auto yield = 10.0; yield <= 15.0; yield += 0.05)
+			{
+				bonds.emplace_back(issue_date, maturity_date, frequency, coupon, calendar, face, round_flows);
+				yields.push_back(from_percent(yield));
+			}
+		bonds.emplace_back(issue_date, 2014y / January / 1d, frequency, coupon, calendar, face, round_flows);
+		yields.push_back(from_percent(13.66));
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		auto counters = mixed_precision_counters{};
+
+		auto prices = vector<double>(bonds.size());
+		ANBIMA.price_batch_vectorised(yields, bonds, quote, prices, &counters);
+
+		for (auto i = 0uz; i < bonds.size(); ++i)
+			EXPECT_EQ(prices[i], ANBIMA.price(yields[i], bonds[i], quote));
+		EXPECT_EQ(prices.back(), 903.075616);
+
+		EXPECT_EQ(counters.fast + counters.slow, bonds.size());
+		EXPECT_LT(counters.slow, bonds.size() / 100u + 1u);
+	}
+
+	TEST(ANBIMA, price_batch_vectorised3)
+	{
+		const auto issue_date = 2008y / January / 1d; // made up?
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto bonds = vector{
+			debt_security::bond{ issue_date, 2014y / January / 1d, SemiAnnual, cpp_dec_float_50{ 10 }, calendar, face, 5u }
+		};
+		const auto yields = vector{ from_percent(cpp_dec_float_50{ "13.66" }) };
+
+		const auto settlement_date = 2008y / May / 21d;
+
+		const auto ANBIMA = debt_security::ANBIMA<cpp_dec_float_50>{};
+
+		auto counters = mixed_precision_counters{};
+
+		auto prices = vector<cpp_dec_float_50>(bonds.size());
+		ANBIMA.price_batch_vectorised(yields, bonds, debt_security::quote{ settlement_date, face, 6u }, prices, &counters);
+		EXPECT_EQ(prices[0], cpp_dec_float_50{ "903.075616" });
+
+		const auto exact = debt_security::quote{ settlement_date, face }; // no truncation, so only T would do
+		ANBIMA.price_batch_vectorised(yields, bonds, exact, prices, &counters);
+		EXPECT_EQ(prices[0], ANBIMA.price(yields[0], bonds[0], exact));
+
+		EXPECT_EQ(counters.fast, 1u);
+		EXPECT_EQ(counters.slow, 1u);
+
+		EXPECT_THROW(ANBIMA.price_batch_vectorised(yields, bonds, exact, span<cpp_dec_float_50>{}), invalid_argument);
+	}
+
+	TEST(ANBIMA, price_at_yields1)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto LTN = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA<cpp_dec_float_50>{};
+
+		// bids of an auction
+		auto yields = vector<cpp_dec_float_50>{};
+		for (auto yield = cpp_dec_float_50{ "14" }; yield <= cpp_dec_float_50{ "14.5" }; yield += cpp_dec_float_50{ "0.01" })
+			yields.push_back(from_percent(yield));
+
+		auto prices = vector<cpp_dec_float_50>(yields.size());
+		ANBIMA.price_at_yields(yields, LTN, quote, prices);
+
+		for (auto i = 0uz; i < yields.size(); ++i)
+			EXPECT_EQ(prices[i], ANBIMA.price(yields[i], LTN, quote));
+		EXPECT_EQ(prices[36], cpp_dec_float_50{ "753.315323" });
+	}
+
+	TEST(ANBIMA, price_at_yields2)
+	{
+		const auto issue_date = 2008y / January / 1d; // made up?
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+		const auto NTN_F = debt_security::bond{
+			issue_date,
+			maturity_date,
+			frequency,
+			coupon,
+			calendar,
+			face,
+			round_flows
+		};
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yields = vector{ from_percent(13.0), from_percent(13.66), from_percent(14.0) };
+
+		auto prices = vector<double>(yields.size());
+		ANBIMA.price_at_yields(yields, NTN_F, quote, prices);
+
+		for (auto i = 0uz; i < yields.size(); ++i)
+			EXPECT_EQ(prices[i], ANBIMA.price(yields[i], NTN_F, quote));
+		EXPECT_EQ(prices[1], 903.075616);
+
+		EXPECT_THROW(ANBIMA.price_at_yields(yields, NTN_F, quote, span{ prices }.first(2)), invalid_argument);
+	}
+
+	TEST(ANBIMA, price_flows1)
+	{
+		const auto issue_date = 2008y / January / 1d; // made up?
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = cpp_dec_float_50{ 10 };
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto round_flows = 5u;
+		const auto NTN_F = debt_security::bond{
+			issue_date,
+			maturity_date,
+			frequency,
+			coupon,
+			calendar,
+			face,
+			round_flows
+		};
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA<cpp_dec_float_50>{};
+
+		const auto yield = from_percent(cpp_dec_float_50{ "13.66" });
+
+		// the same flows without the bond
+		EXPECT_EQ(ANBIMA.price(yield, NTN_F.cash_flow(), calendar, quote), cpp_dec_float_50{ "903.075616" });
+		EXPECT_EQ(ANBIMA.price(yield, NTN_F.flow_block(), calendar, quote), cpp_dec_float_50{ "903.075616" });
+
+		// as they might come from a file (in any order)
+		auto flows = vector<cash_flow<cpp_dec_float_50>>{};
+		for (const auto& flow : NTN_F.cash_flow())
+			flows.insert(flows.begin(), flow);
+		EXPECT_EQ(ANBIMA.price(yield, flows, calendar, quote), cpp_dec_float_50{ "903.075616" });
+		EXPECT_EQ(ANBIMA.price(yield, span{ flows }.first(0), calendar, quote), cpp_dec_float_50{ 0 });
+	}
+
+	TEST(ANBIMA, price_flows2)
+	{
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		// an LTN is a single flow
+		const auto flows = array{ cash_flow{ 2010y / July / 1d, face } };
+		EXPECT_EQ(ANBIMA.price(from_percent(14.36), flows, calendar, quote), 753.315323);
+	}
+
+	TEST(ANBIMA, quotation1)
+	{
+		const auto issue_date = 2008y / January / 1d; // made up?
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+		const auto NTN_F = debt_security::bond{
+			issue_date,
+			maturity_date,
+			frequency,
+			coupon,
+			calendar,
+			face,
+			round_flows
+		};
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = from_percent(13.66);
+		const auto q = ANBIMA.quotation(yield, NTN_F, quote);
+		EXPECT_EQ(q.dirty_price, 903.075616);
+		EXPECT_EQ(q.dirty_price, ANBIMA.price(yield, NTN_F, quote));
+
+		// the first coupon accrues from the issue date
+		const auto days_accrued = calendar.count_business_days(days_period{ issue_date, 2008y / May / 20d });
+		const auto days_in_period = calendar.count_business_days(days_period{ issue_date, 2008y / June / 30d });
+		EXPECT_DOUBLE_EQ(q.accrued_interest, 48.80885 * days_accrued / days_in_period);
+		EXPECT_DOUBLE_EQ(q.clean_price, q.dirty_price - q.accrued_interest);
+		EXPECT_DOUBLE_EQ(q.quotation, q.clean_price / 10.0);
+	}
+
+	TEST(ANBIMA, quotation2)
+	{
+		const auto issue_date = 2008y / January / 1d;
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+		const auto NTN_F = debt_security::bond{
+			issue_date,
+			maturity_date,
+			frequency,
+			coupon,
+			calendar,
+			face,
+			round_flows
+		};
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = from_percent(13.66);
+
+		// the coupon paid on the settlement date is gone, and the next one has not started to accrue
+		const auto on_coupon = debt_security::quote{ 2008y / July / 1d, face };
+		const auto q = ANBIMA.quotation(yield, NTN_F, on_coupon);
+		EXPECT_EQ(q.accrued_interest, 0.0);
+		EXPECT_EQ(q.clean_price, q.dirty_price);
+
+		const auto after_coupon = debt_security::quote{ 2008y / July / 2d, face };
+		const auto r = ANBIMA.quotation(yield, NTN_F, after_coupon);
+		EXPECT_GT(r.accrued_interest, 0.0);
+		EXPECT_LT(r.accrued_interest, 1.0); // a single business day of the coupon
+		EXPECT_GT(r.dirty_price, q.dirty_price); // a day closer to the flows, with none paid in between
+		EXPECT_LT(r.dirty_price - q.dirty_price, 1.0);
+
+		// in the final period the principal does not accrue
+		const auto final_period = debt_security::quote{ 2013y / October / 1d, face };
+		const auto s = ANBIMA.quotation(yield, NTN_F, final_period);
+		EXPECT_GT(s.accrued_interest, 0.0);
+		EXPECT_LT(s.accrued_interest, 48.80885);
+
+		const auto matured = debt_security::quote{ 2014y / January / 2d, face };
+		EXPECT_THROW(ANBIMA.quotation(yield, NTN_F, matured), domain_error);
+	}
+
+	TEST(ANBIMA, quotation3)
+	{
+		const auto issue_date = 2008y / January / 1d;
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+		const auto NTN_F = debt_security::bond{
+			issue_date,
+			maturity_date,
+			frequency,
+			coupon,
+			calendar,
+			face,
+			round_flows
+		};
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto quote = debt_security::quote{ settlement_date, face, 6u };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = from_percent(13.66);
+		const auto truncation = debt_security::quotation_truncation{ 6u, 6u, 4u };
+		const auto q = ANBIMA.quotation(yield, NTN_F, quote, truncation);
+
+		// each field is truncated as it is quoted, and the clean price is from the quoted fields
+		EXPECT_EQ(q.accrued_interest, trunc_dp(q.accrued_interest, 6u));
+		EXPECT_EQ(q.clean_price, trunc_dp(q.dirty_price - q.accrued_interest, 6u));
+		EXPECT_EQ(q.quotation, trunc_dp(q.clean_price / 10.0, 4u));
+	}
+
+	TEST(ANBIMA, quotation5)
+	{
+		const auto issue_date = 2008y / January / 1d;
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+		const auto NTN_F = debt_security::bond{ issue_date, maturity_date, frequency, coupon, calendar, face, round_flows };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = from_percent(13.66);
+
+		// seasoned, and on a coupon date, so the same flows go into both
+		for (const auto settlement_date : { 2009y / March / 16d, 2010y / July / 1d, 2013y / December / 2d })
+		{
+			const auto quote = debt_security::quote{ settlement_date, face, 6u };
+			EXPECT_EQ(ANBIMA.quotation(yield, NTN_F, quote).dirty_price, ANBIMA.price(yield, NTN_F, quote));
+		}
+	}
+
+	TEST(ANBIMA, quotation4)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto LTN = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ settlement_date, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA<cpp_dec_float_50>{};
+
+		const auto yield = from_percent(cpp_dec_float_50{ "14.36" });
+		const auto truncation = debt_security::quotation_truncation{ .quotation = 4u };
+		const auto q = ANBIMA.quotation(yield, LTN, quote, truncation);
+
+		EXPECT_EQ(q.dirty_price, cpp_dec_float_50{ "753.315323" });
+		EXPECT_EQ(q.accrued_interest, cpp_dec_float_50{ 0 });
+		EXPECT_EQ(q.clean_price, q.dirty_price);
+		EXPECT_EQ(q.quotation, cpp_dec_float_50{ "75.3315" });
+	}
+
 }
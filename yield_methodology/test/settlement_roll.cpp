@@ -0,0 +1,225 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2025 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <boost/multiprecision/cpp_dec_float.hpp>
+
+#include <settlement_roll.h>
+#include <ANBIMA.h>
+#include <bill.h>
+#include <bond.h>
+#include <quote.h>
+
+#include <resets_math.h>
+
+#include <period.h>
+#include <calendar.h>
+#include <static_data.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <span>
+#include <stdexcept>
+
+using namespace std;
+using namespace std::chrono;
+using namespace boost::multiprecision;
+using namespace gregorian;
+using namespace gregorian::util;
+using namespace fin_calendar;
+using namespace reset;
+using namespace gregorian::static_data;
+
+
+namespace debt_security
+{
+
+	static auto _NTN_F() -> bond<double>
+	{
+		const auto issue_date = 2008y / January / 1d;
+		const auto maturity_date = 2014y / January / 1d;
+		const auto frequency = SemiAnnual;
+		const auto coupon = 10.0;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+
+		return bond{
+			issue_date,
+			maturity_date,
+			frequency,
+			coupon,
+			calendar,
+			face,
+			round_flows
+		};
+	}
+
+
+	TEST(settlement_roll, roll1)
+	{
+		const auto NTN_F = _NTN_F();
+
+		const auto face = 1'000.0;
+		const auto truncate = 6u;
+		const auto quote = debt_security::quote{ 2008y / May / 21d, face, truncate };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = from_percent(13.66);
+
+		auto roll = settlement_roll{ NTN_F, quote };
+		EXPECT_EQ(roll.size(), 12uz);
+		EXPECT_EQ(roll.price(yield), 903.075616);
+
+		roll.advance();
+		EXPECT_EQ(roll.get_settlement_date(), 2008y / May / 23d); // Corpus Christi is not a business day
+		EXPECT_EQ(roll.price(yield), ANBIMA.price(yield, NTN_F, debt_security::quote{ 2008y / May / 23d, face, truncate }));
+
+		roll.advance(20);
+		const auto settlement_date = roll.get_settlement_date();
+		EXPECT_EQ(roll.price(yield), ANBIMA.price(yield, NTN_F, debt_security::quote{ settlement_date, face, truncate }));
+
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		EXPECT_EQ(
+			static_cast<size_t>(roll.business_days(0uz)),
+			calendar.count_business_days(days_period{ settlement_date, 2008y / June / 30d })
+		);
+	}
+
+	TEST(settlement_roll, roll2)
+	{
+		const auto NTN_F = _NTN_F();
+
+		const auto quote = debt_security::quote{ 2008y / May / 21d, 1'000.0, 6u };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = from_percent(13.66);
+
+		auto roll = settlement_roll{ NTN_F, quote };
+
+		// the first coupon is paid, so it goes
+		for (const auto settlement_date : { 2008y / July / 1d, 2008y / July / 2d, 2009y / January / 5d, 2013y / December / 31d })
+		{
+			roll.roll_to(settlement_date);
+
+			const auto q = debt_security::quote{ settlement_date, 1'000.0, 6u };
+			EXPECT_EQ(roll.price(yield), ANBIMA.quotation(yield, NTN_F, q).dirty_price);
+		}
+		EXPECT_EQ(roll.size(), 1uz);
+
+		EXPECT_THROW(roll.roll_to(2013y / December / 30d), invalid_argument);
+		EXPECT_THROW(roll.advance(-1), invalid_argument);
+
+		roll.roll_to(2014y / January / 2d);
+		EXPECT_TRUE(roll.empty());
+		EXPECT_THROW(roll.price(yield), domain_error);
+
+		roll.advance(); // nothing left to count business days for
+		EXPECT_TRUE(roll.empty());
+	}
+
+	TEST(settlement_roll, roll3)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = cpp_dec_float_50{ 1'000 };
+		const auto LTN = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto quote = debt_security::quote{ 2008y / May / 21d, face, 6u };
+
+		const auto ANBIMA = debt_security::ANBIMA<cpp_dec_float_50>{};
+
+		const auto yield = from_percent(cpp_dec_float_50{ "14.36" });
+
+		auto roll = settlement_roll{ LTN, quote };
+		EXPECT_EQ(roll.price(yield), cpp_dec_float_50{ "753.315323" });
+
+		for (auto i = 0; i < 10; ++i)
+		{
+			roll.advance();
+			EXPECT_EQ(roll.price(yield), ANBIMA.price(yield, LTN, debt_security::quote{ roll.get_settlement_date(), face, 6u }));
+		}
+	}
+
+	TEST(settlement_roll, price_series1)
+	{
+		const auto issue_date = 2007y / July / 1d;
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto LTN = debt_security::bill{ issue_date, maturity_date, calendar, face };
+
+		const auto quote = debt_security::quote{ 2008y / May / 21d, face, 6u };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = from_percent(14.36);
+
+		// every calendar day for a year, business days or not
+		auto settlement_dates = vector<year_month_day>{};
+		for (auto d = sys_days{ 2008y / May / 21d }; d < sys_days{ 2009y / May / 21d }; d += days{ 1 })
+			settlement_dates.emplace_back(d);
+
+		auto prices = vector<double>(settlement_dates.size());
+		price_series(yield, LTN, quote, settlement_dates, prices);
+
+		auto span_prices = vector<double>(settlement_dates.size());
+		price_series(yield, LTN, quote, span<const year_month_day>{ settlement_dates }, span<double>{ span_prices });
+		EXPECT_EQ(span_prices, prices);
+
+		for (auto i = 0uz; i < settlement_dates.size(); ++i)
+			EXPECT_EQ(prices[i], ANBIMA.price(yield, LTN, debt_security::quote{ settlement_dates[i], face, 6u }));
+	}
+
+	TEST(settlement_roll, price_series2)
+	{
+		const auto NTN_F = _NTN_F();
+
+		const auto quote = debt_security::quote{ 2008y / May / 21d, 1'000.0, 6u };
+
+		const auto ANBIMA = debt_security::ANBIMA{};
+
+		const auto yield = from_percent(13.66);
+
+		const auto settlement_dates = vector{ 2008y / June / 30d, 2008y / July / 1d, 2008y / July / 2d, 2010y / March / 15d };
+		auto prices = vector<double>(settlement_dates.size());
+		price_series(yield, NTN_F, quote, settlement_dates, prices);
+
+		for (auto i = 0uz; i < settlement_dates.size(); ++i)
+			EXPECT_EQ(prices[i], ANBIMA.quotation(yield, NTN_F, debt_security::quote{ settlement_dates[i], 1'000.0, 6u }).dirty_price);
+
+		// spans rather than vectors
+		auto span_prices = vector<double>(settlement_dates.size());
+		price_series(yield, NTN_F, quote, span<const year_month_day>{ settlement_dates }, span<double>{ span_prices });
+		EXPECT_EQ(span_prices, prices);
+
+		const auto unordered = vector{ 2008y / July / 2d, 2008y / July / 1d };
+		auto two = vector<double>(2uz);
+		EXPECT_THROW(price_series(yield, NTN_F, quote, unordered, two), invalid_argument);
+		EXPECT_THROW(price_series(yield, NTN_F, quote, settlement_dates, two), invalid_argument);
+	}
+
+}
@@ -22,10 +22,20 @@
 
 #include <yield_methodology.h>
 
+#include <resets_math.h>
+
+#include <static_data.h>
+
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 using namespace std;
 using namespace std::chrono;
+using namespace fin_calendar;
+using namespace reset;
+using namespace gregorian::static_data;
 
 
 namespace debt_security
@@ -38,4 +48,149 @@ namespace debt_security
 		yield_method = ANBIMA{};
 	}
 
+	TEST(yield_methodology, yield1)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto LTN = bill{ issue_date, maturity_date, calendar, face };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto q = quote{ settlement_date, face, truncate };
+
+		const auto yield_method = yield_methodology{ ANBIMA{} };
+
+		const auto price = yield_to_price(from_percent(14.36), LTN, q, yield_method);
+		const auto yield = price_to_yield(price, LTN, q, yield_method);
+		EXPECT_NEAR(yield, from_percent(14.36), 1e-8);
+	}
+
+	TEST(yield_methodology, price_batch1)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto bills = vector{
+			bill{ issue_date, 2009y / January / 1d, calendar, face },
+			bill{ issue_date, 2010y / July / 1d, calendar, face }
+		};
+		const auto yields = vector{ from_percent(13.0), from_percent(14.36) };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto q = quote{ settlement_date, face, truncate };
+
+		const auto yield_method = yield_methodology{ ANBIMA{} };
+
+		auto prices = vector<double>(bills.size());
+		yield_to_price_batch(yields, bills, q, yield_method, prices);
+
+		for (auto i = 0uz; i < bills.size(); ++i)
+			EXPECT_EQ(prices[i], yield_to_price(yields[i], bills[i], q, yield_method));
+	}
+
+	TEST(yield_methodology, static1)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto maturity_date = 2010y / July / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto LTN = bill{ issue_date, maturity_date, calendar, face };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto q = quote{ settlement_date, face, truncate };
+
+		const auto yield_method = ANBIMA{}; // bound at compile time
+
+		const auto price = yield_to_price(from_percent(14.36), LTN, q, yield_method);
+		EXPECT_EQ(price, 753.315323);
+		EXPECT_EQ(price, yield_to_price(from_percent(14.36), LTN, q, yield_methodology{ yield_method }));
+
+		const auto yield = price_to_yield(price, LTN, q, yield_method);
+		EXPECT_NEAR(yield, from_percent(14.36), 1e-8);
+	}
+
+	TEST(yield_methodology, bond1)
+	{
+		const auto issue_date = 2008y / January / 1d; // made up?
+		const auto maturity_date = 2014y / January / 1d;
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto round_flows = 5u;
+		const auto NTN_F = bond{ issue_date, maturity_date, SemiAnnual, 10.0, calendar, face, round_flows };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto q = quote{ settlement_date, face, truncate };
+
+		const auto yield_method = yield_methodology{ ANBIMA{} };
+
+		const auto price = yield_to_price(from_percent(13.66), NTN_F, q, yield_method);
+		EXPECT_EQ(price, 903.075616);
+		EXPECT_EQ(price, yield_to_price(from_percent(13.66), NTN_F, q, ANBIMA{}));
+
+		const auto yield = price_to_yield(price, NTN_F, q, yield_method);
+		EXPECT_NEAR(yield, from_percent(13.66), 1e-8);
+		EXPECT_EQ(yield, price_to_yield(price, NTN_F, q, ANBIMA{}));
+	}
+
+	TEST(yield_methodology, price_batch2)
+	{
+		const auto issue_date = 2008y / January / 1d; // made up?
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto bonds = vector{
+			bond{ issue_date, 2012y / January / 1d, SemiAnnual, 10.0, calendar, face, 5u },
+			bond{ issue_date, 2014y / January / 1d, SemiAnnual, 10.0, calendar, face, 5u }
+		};
+		const auto yields = vector{ from_percent(13.1), from_percent(13.66) };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto q = quote{ settlement_date, face, truncate };
+
+		const auto yield_method = yield_methodology{ ANBIMA{} };
+
+		auto prices = vector<double>(bonds.size());
+		yield_to_price_batch(yields, bonds, q, yield_method, prices);
+
+		auto static_prices = vector<double>(bonds.size());
+		yield_to_price_batch(yields, bonds, q, ANBIMA{}, static_prices);
+
+		EXPECT_EQ(prices, static_prices);
+		EXPECT_EQ(prices[1], 903.075616);
+	}
+
+	TEST(yield_methodology, with_yield_methodology1)
+	{
+		const auto issue_date = 2007y / July / 1d; // made up (does not matter)
+		const auto& calendar = locate_calendar("America/ANBIMA"s);
+		const auto face = 1'000.0;
+		const auto LTN = bill{ issue_date, 2010y / July / 1d, calendar, face };
+
+		const auto settlement_date = 2008y / May / 21d;
+		const auto truncate = 6u;
+		const auto q = quote{ settlement_date, face, truncate };
+
+		const auto yield_method = yield_methodology{ ANBIMA{} };
+
+		// one visit for the whole loop
+		const auto prices = with_yield_methodology(
+			yield_method,
+			[&](const auto& yield_method)
+			{
+				auto result = vector<double>{};
+				for (auto yield = 14.0; yield <= 14.5; yield += 0.01)
+					result.push_back(yield_to_price(from_percent(yield), LTN, q, yield_method));
+				return result;
+			}
+		);
+
+		ASSERT_EQ(prices.size(), 51uz);
+		EXPECT_EQ(prices[0], yield_to_price(from_percent(14.0), LTN, q, yield_method));
+	}
+
 }